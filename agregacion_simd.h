@@ -0,0 +1,258 @@
+#ifndef AGREGACION_SIMD_H
+#define AGREGACION_SIMD_H
+
+#include <cstring>
+#include <cstddef>
+#include <climits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#define AGREGACION_X86
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// ============================================================================
+// AGREGACIONES VECTORIZADAS SOBRE COLUMNAS
+// ============================================================================
+// Sumas y minimo/maximo sobre un arreglo contiguo de valores (una columna de
+// las proyecciones de funciones.H) con un byte de seleccion por posicion:
+// solo entran las posiciones con seleccion distinta de 0. La seleccion se
+// aplica como mascara, sin saltos: los valores que no entran se vuelven 0
+// (sumas) o el neutro (minimo/maximo).
+//
+// Igual que busqueda_simd.h: SSE2 en x86, AVX2 si el procesador lo tiene
+// (se elige al iniciar) y la version escalar fuera de x86. Las agrupaciones
+// (sumar o contar por doctor, por mes...) escriben en posiciones que
+// dependen del valor y quedan escalares.
+
+// FUNCION: Versiones escalares (referencia y respaldo)
+long long sumarEnterosEscalar(const int* valores, const unsigned char* seleccion, size_t n, long& cantidad) {
+    long long suma = 0;
+    cantidad = 0;
+    for (size_t i = 0; i < n; i++) {
+        bool entra = seleccion[i] != 0;
+        suma += entra ? valores[i] : 0;
+        cantidad += entra;
+    }
+    return suma;
+}
+
+double sumarDecimalesEscalar(const float* valores, const unsigned char* seleccion, size_t n) {
+    double suma = 0;
+    for (size_t i = 0; i < n; i++) {
+        suma += seleccion[i] != 0 ? (double)valores[i] : 0.0;
+    }
+    return suma;
+}
+
+// false si no hay ninguna posicion seleccionada
+bool minMaxEnterosEscalar(const int* valores, const unsigned char* seleccion, size_t n, int& minimo, int& maximo) {
+    minimo = INT_MAX;
+    maximo = INT_MIN;
+    bool alguno = false;
+    for (size_t i = 0; i < n; i++) {
+        if (seleccion[i] == 0) continue;
+        minimo = valores[i] < minimo ? valores[i] : minimo;
+        maximo = valores[i] > maximo ? valores[i] : maximo;
+        alguno = true;
+    }
+    return alguno;
+}
+
+#ifdef AGREGACION_X86
+
+// 4 bytes de seleccion -> mascara de 4 enteros (todo 1 si entra)
+inline __m128i mascaraSeleccionSSE2(const unsigned char* seleccion) {
+    int bytes;
+    memcpy(&bytes, seleccion, sizeof(int));
+    const __m128i cero = _mm_setzero_si128();
+    __m128i ancho = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), cero), cero);
+    return _mm_cmpgt_epi32(ancho, cero);
+}
+
+// FUNCION: Versiones SSE2 (4 valores por iteracion). Los enteros se
+// extienden a 64 bits con su signo antes de sumar.
+long long sumarEnterosSSE2(const int* valores, const unsigned char* seleccion, size_t n, long& cantidad) {
+    __m128i suma = _mm_setzero_si128(), cuenta = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i mascara = mascaraSeleccionSSE2(seleccion + i);
+        __m128i x = _mm_and_si128(_mm_loadu_si128((const __m128i*)(valores + i)), mascara);
+        __m128i signo = _mm_srai_epi32(x, 31);
+        suma = _mm_add_epi64(suma, _mm_unpacklo_epi32(x, signo));
+        suma = _mm_add_epi64(suma, _mm_unpackhi_epi32(x, signo));
+        cuenta = _mm_sub_epi32(cuenta, mascara);
+    }
+    long long sumas[2];
+    int cuentas[4];
+    _mm_storeu_si128((__m128i*)sumas, suma);
+    _mm_storeu_si128((__m128i*)cuentas, cuenta);
+
+    long resto;
+    long long total = sumas[0] + sumas[1] + sumarEnterosEscalar(valores + i, seleccion + i, n - i, resto);
+    cantidad = (long)cuentas[0] + cuentas[1] + cuentas[2] + cuentas[3] + resto;
+    return total;
+}
+
+double sumarDecimalesSSE2(const float* valores, const unsigned char* seleccion, size_t n) {
+    __m128d sumaBaja = _mm_setzero_pd(), sumaAlta = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x = _mm_and_ps(_mm_loadu_ps(valores + i), _mm_castsi128_ps(mascaraSeleccionSSE2(seleccion + i)));
+        sumaBaja = _mm_add_pd(sumaBaja, _mm_cvtps_pd(x));
+        sumaAlta = _mm_add_pd(sumaAlta, _mm_cvtps_pd(_mm_movehl_ps(x, x)));
+    }
+    double sumas[2];
+    _mm_storeu_pd(sumas, _mm_add_pd(sumaBaja, sumaAlta));
+    return sumas[0] + sumas[1] + sumarDecimalesEscalar(valores + i, seleccion + i, n - i);
+}
+
+// SSE2 no tiene minimo/maximo de enteros de 32 bits: se elige con la
+// comparacion como mascara
+inline __m128i elegirSSE2(__m128i mascara, __m128i si, __m128i no) {
+    return _mm_or_si128(_mm_and_si128(mascara, si), _mm_andnot_si128(mascara, no));
+}
+
+bool minMaxEnterosSSE2(const int* valores, const unsigned char* seleccion, size_t n, int& minimo, int& maximo) {
+    const __m128i mayor = _mm_set1_epi32(INT_MAX), menor = _mm_set1_epi32(INT_MIN);
+    __m128i minimos = mayor, maximos = menor, alguno = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i mascara = mascaraSeleccionSSE2(seleccion + i);
+        __m128i x = _mm_loadu_si128((const __m128i*)(valores + i));
+        __m128i paraMinimo = elegirSSE2(mascara, x, mayor);
+        __m128i paraMaximo = elegirSSE2(mascara, x, menor);
+        minimos = elegirSSE2(_mm_cmplt_epi32(paraMinimo, minimos), paraMinimo, minimos);
+        maximos = elegirSSE2(_mm_cmpgt_epi32(paraMaximo, maximos), paraMaximo, maximos);
+        alguno = _mm_or_si128(alguno, mascara);
+    }
+    int minimosCarriles[4], maximosCarriles[4];
+    _mm_storeu_si128((__m128i*)minimosCarriles, minimos);
+    _mm_storeu_si128((__m128i*)maximosCarriles, maximos);
+
+    bool hayAlguno = minMaxEnterosEscalar(valores + i, seleccion + i, n - i, minimo, maximo);
+    for (int k = 0; k < 4; k++) {
+        minimo = minimosCarriles[k] < minimo ? minimosCarriles[k] : minimo;
+        maximo = maximosCarriles[k] > maximo ? maximosCarriles[k] : maximo;
+    }
+    return hayAlguno || _mm_movemask_epi8(alguno) != 0;
+}
+
+#if defined(__GNUC__)
+// 8 bytes de seleccion -> mascara de 8 enteros
+__attribute__((target("avx2")))
+inline __m256i mascaraSeleccionAVX2(const unsigned char* seleccion) {
+    __m256i ancho = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)seleccion));
+    return _mm256_cmpgt_epi32(ancho, _mm256_setzero_si256());
+}
+
+// FUNCION: Versiones AVX2 (8 valores por iteracion)
+__attribute__((target("avx2")))
+long long sumarEnterosAVX2(const int* valores, const unsigned char* seleccion, size_t n, long& cantidad) {
+    __m256i suma = _mm256_setzero_si256(), cuenta = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i mascara = mascaraSeleccionAVX2(seleccion + i);
+        __m256i x = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(valores + i)), mascara);
+        suma = _mm256_add_epi64(suma, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x)));
+        suma = _mm256_add_epi64(suma, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)));
+        cuenta = _mm256_sub_epi32(cuenta, mascara);
+    }
+    long long sumas[4];
+    int cuentas[8];
+    _mm256_storeu_si256((__m256i*)sumas, suma);
+    _mm256_storeu_si256((__m256i*)cuentas, cuenta);
+
+    long resto;
+    long long total = sumas[0] + sumas[1] + sumas[2] + sumas[3] +
+                      sumarEnterosSSE2(valores + i, seleccion + i, n - i, resto);
+    cantidad = resto;
+    for (int k = 0; k < 8; k++) cantidad += cuentas[k];
+    return total;
+}
+
+__attribute__((target("avx2")))
+double sumarDecimalesAVX2(const float* valores, const unsigned char* seleccion, size_t n) {
+    __m256d sumaBaja = _mm256_setzero_pd(), sumaAlta = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x = _mm256_and_ps(_mm256_loadu_ps(valores + i), _mm256_castsi256_ps(mascaraSeleccionAVX2(seleccion + i)));
+        sumaBaja = _mm256_add_pd(sumaBaja, _mm256_cvtps_pd(_mm256_castps256_ps128(x)));
+        sumaAlta = _mm256_add_pd(sumaAlta, _mm256_cvtps_pd(_mm256_extractf128_ps(x, 1)));
+    }
+    double sumas[4];
+    _mm256_storeu_pd(sumas, _mm256_add_pd(sumaBaja, sumaAlta));
+    return sumas[0] + sumas[1] + sumas[2] + sumas[3] + sumarDecimalesSSE2(valores + i, seleccion + i, n - i);
+}
+
+__attribute__((target("avx2")))
+bool minMaxEnterosAVX2(const int* valores, const unsigned char* seleccion, size_t n, int& minimo, int& maximo) {
+    const __m256i mayor = _mm256_set1_epi32(INT_MAX), menor = _mm256_set1_epi32(INT_MIN);
+    __m256i minimos = mayor, maximos = menor, alguno = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i mascara = mascaraSeleccionAVX2(seleccion + i);
+        __m256i x = _mm256_loadu_si256((const __m256i*)(valores + i));
+        minimos = _mm256_min_epi32(minimos, _mm256_blendv_epi8(mayor, x, mascara));
+        maximos = _mm256_max_epi32(maximos, _mm256_blendv_epi8(menor, x, mascara));
+        alguno = _mm256_or_si256(alguno, mascara);
+    }
+    int minimosCarriles[8], maximosCarriles[8];
+    _mm256_storeu_si256((__m256i*)minimosCarriles, minimos);
+    _mm256_storeu_si256((__m256i*)maximosCarriles, maximos);
+
+    bool hayAlguno = minMaxEnterosSSE2(valores + i, seleccion + i, n - i, minimo, maximo);
+    for (int k = 0; k < 8; k++) {
+        minimo = minimosCarriles[k] < minimo ? minimosCarriles[k] : minimo;
+        maximo = maximosCarriles[k] > maximo ? maximosCarriles[k] : maximo;
+    }
+    return hayAlguno || _mm256_movemask_epi8(alguno) != 0;
+}
+#endif
+
+#endif // AGREGACION_X86
+
+struct KernelsAgregacion {
+    long long (*sumarEnteros)(const int*, const unsigned char*, size_t, long&);
+    double (*sumarDecimales)(const float*, const unsigned char*, size_t);
+    bool (*minMaxEnteros)(const int*, const unsigned char*, size_t, int&, int&);
+};
+
+// FUNCION: Elegir la mejor version disponible en este procesador
+KernelsAgregacion elegirKernelsAgregacion() {
+#if defined(AGREGACION_X86) && defined(__GNUC__)
+    if (__builtin_cpu_supports("avx2")) return {sumarEnterosAVX2, sumarDecimalesAVX2, minMaxEnterosAVX2};
+#endif
+#ifdef AGREGACION_X86
+    return {sumarEnterosSSE2, sumarDecimalesSSE2, minMaxEnterosSSE2};
+#else
+    return {sumarEnterosEscalar, sumarDecimalesEscalar, minMaxEnterosEscalar};
+#endif
+}
+
+const KernelsAgregacion kernelsAgregacion = elegirKernelsAgregacion();
+
+// ============================================================================
+// AGRUPACIONES
+// ============================================================================
+
+// FUNCION: Sumar valores y contar por grupo. Los grupos seleccionados
+// tienen que estar en [desde, desde + cantidad de sumas) (ver minMaxEnteros).
+void sumarPorGrupo(const int* grupos, const float* valores, const unsigned char* seleccion, size_t n,
+                   int desde, double* sumas, long* conteos) {
+    for (size_t i = 0; i < n; i++) {
+        if (seleccion[i] == 0) continue;
+        sumas[grupos[i] - desde] += valores[i];
+        conteos[grupos[i] - desde]++;
+    }
+}
+
+// FUNCION: Contar por grupo (histograma), con la misma condicion sobre los grupos
+void contarPorGrupo(const int* grupos, const unsigned char* seleccion, size_t n, int desde, long* conteos) {
+    for (size_t i = 0; i < n; i++) {
+        if (seleccion[i] != 0) conteos[grupos[i] - desde]++;
+    }
+}
+
+#endif //AGREGACION_SIMD_H
@@ -0,0 +1,173 @@
+#ifndef BUSQUEDA_SIMD_H
+#define BUSQUEDA_SIMD_H
+
+#include <cstring>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#define BUSQUEDA_X86
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// ============================================================================
+// BUSQUEDA VECTORIZADA DE SUBCADENAS
+// ============================================================================
+// Para campos de texto libre sin indice (observaciones, motivo, alergias...).
+// Se comparan a la vez 16 (SSE2) o 32 (AVX2) posiciones contra el primer y el
+// ultimo byte del patron; solo las posiciones donde coinciden ambos se
+// verifican byte a byte. AVX2 se elige en tiempo de ejecucion si el
+// procesador lo tiene; fuera de x86 se usa la version escalar.
+//
+// Sin mayusculas: solo letras ASCII ("Penicilina" encuentra "PENICILINA").
+
+const size_t SUBCADENA_NO_ENCONTRADA = (size_t)-1;
+
+inline unsigned char minusculaASCII(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? c + 32 : c;
+}
+
+inline bool esLetraASCII(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+}
+
+// Compara largo bytes; sinMayusculas ignora mayusculas en letras ASCII
+inline bool coincideEn(const char* texto, const char* patron, size_t largo, bool sinMayusculas) {
+    if (!sinMayusculas) return memcmp(texto, patron, largo) == 0;
+    for (size_t i = 0; i < largo; i++) {
+        if (minusculaASCII(texto[i]) != minusculaASCII(patron[i])) return false;
+    }
+    return true;
+}
+
+// FUNCION: Version escalar (referencia y respaldo)
+size_t buscarSubcadenaEscalar(const char* texto, size_t largo, size_t /*capacidad*/,
+                              const char* patron, size_t largoPatron, bool sinMayusculas) {
+    if (largoPatron == 0) return 0;
+    if (largoPatron > largo) return SUBCADENA_NO_ENCONTRADA;
+    unsigned char primero = minusculaASCII(patron[0]);
+    for (size_t i = 0; i + largoPatron <= largo; i++) {
+        unsigned char c = sinMayusculas ? minusculaASCII(texto[i]) : (unsigned char)texto[i];
+        if (c == (sinMayusculas ? primero : (unsigned char)patron[0]) &&
+            coincideEn(texto + i, patron, largoPatron, sinMayusculas)) {
+            return i;
+        }
+    }
+    return SUBCADENA_NO_ENCONTRADA;
+}
+
+#ifdef BUSQUEDA_X86
+
+// Primer y ultimo byte del patron, con el bit 0x20 forzado en las letras si
+// se ignoran mayusculas ('A' | 0x20 == 'a'; ningun otro byte da 'a')
+struct BordesPatron {
+    unsigned char primero, ultimo;
+    unsigned char mascaraPrimero, mascaraUltimo;
+};
+
+inline BordesPatron bordesPatron(const char* patron, size_t largoPatron, bool sinMayusculas) {
+    BordesPatron b;
+    unsigned char p = patron[0], u = patron[largoPatron - 1];
+    b.mascaraPrimero = (sinMayusculas && esLetraASCII(p)) ? 0x20 : 0;
+    b.mascaraUltimo = (sinMayusculas && esLetraASCII(u)) ? 0x20 : 0;
+    b.primero = p | b.mascaraPrimero;
+    b.ultimo = u | b.mascaraUltimo;
+    return b;
+}
+
+// FUNCION: Version SSE2 (16 posiciones por iteracion). Las cargas llegan
+// hasta capacidad (el tamanio fijo del campo); los candidatos se limitan a largo.
+size_t buscarSubcadenaSSE2(const char* texto, size_t largo, size_t capacidad,
+                           const char* patron, size_t largoPatron, bool sinMayusculas) {
+    if (largoPatron == 0) return 0;
+    if (largoPatron > largo) return SUBCADENA_NO_ENCONTRADA;
+
+    BordesPatron b = bordesPatron(patron, largoPatron, sinMayusculas);
+    const __m128i primero = _mm_set1_epi8((char)b.primero);
+    const __m128i ultimo = _mm_set1_epi8((char)b.ultimo);
+    const __m128i mascaraPrimero = _mm_set1_epi8((char)b.mascaraPrimero);
+    const __m128i mascaraUltimo = _mm_set1_epi8((char)b.mascaraUltimo);
+    size_t posiciones = largo - largoPatron + 1;
+
+    size_t i = 0;
+    for (; i < posiciones && i + largoPatron - 1 + 16 <= capacidad; i += 16) {
+        __m128i bloquePrimero = _mm_or_si128(_mm_loadu_si128((const __m128i*)(texto + i)), mascaraPrimero);
+        __m128i bloqueUltimo = _mm_or_si128(_mm_loadu_si128((const __m128i*)(texto + i + largoPatron - 1)), mascaraUltimo);
+        unsigned int candidatos = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(bloquePrimero, primero),
+                                                                  _mm_cmpeq_epi8(bloqueUltimo, ultimo)));
+        while (candidatos != 0) {
+            size_t posicion = i + __builtin_ctz(candidatos);
+            if (posicion >= posiciones) break;
+            if (coincideEn(texto + posicion, patron, largoPatron, sinMayusculas)) return posicion;
+            candidatos &= candidatos - 1;
+        }
+    }
+
+    if (i >= posiciones) return SUBCADENA_NO_ENCONTRADA;
+    size_t resto = buscarSubcadenaEscalar(texto + i, largo - i, capacidad - i, patron, largoPatron, sinMayusculas);
+    return resto == SUBCADENA_NO_ENCONTRADA ? resto : i + resto;
+}
+
+#if defined(__GNUC__)
+// FUNCION: Version AVX2 (32 posiciones por iteracion)
+__attribute__((target("avx2")))
+size_t buscarSubcadenaAVX2(const char* texto, size_t largo, size_t capacidad,
+                           const char* patron, size_t largoPatron, bool sinMayusculas) {
+    if (largoPatron == 0) return 0;
+    if (largoPatron > largo) return SUBCADENA_NO_ENCONTRADA;
+
+    BordesPatron b = bordesPatron(patron, largoPatron, sinMayusculas);
+    const __m256i primero = _mm256_set1_epi8((char)b.primero);
+    const __m256i ultimo = _mm256_set1_epi8((char)b.ultimo);
+    const __m256i mascaraPrimero = _mm256_set1_epi8((char)b.mascaraPrimero);
+    const __m256i mascaraUltimo = _mm256_set1_epi8((char)b.mascaraUltimo);
+    size_t posiciones = largo - largoPatron + 1;
+
+    size_t i = 0;
+    for (; i < posiciones && i + largoPatron - 1 + 32 <= capacidad; i += 32) {
+        __m256i bloquePrimero = _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(texto + i)), mascaraPrimero);
+        __m256i bloqueUltimo = _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(texto + i + largoPatron - 1)), mascaraUltimo);
+        unsigned int candidatos = (unsigned int)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(bloquePrimero, primero), _mm256_cmpeq_epi8(bloqueUltimo, ultimo)));
+        while (candidatos != 0) {
+            size_t posicion = i + __builtin_ctz(candidatos);
+            if (posicion >= posiciones) break;
+            if (coincideEn(texto + posicion, patron, largoPatron, sinMayusculas)) return posicion;
+            candidatos &= candidatos - 1;
+        }
+    }
+
+    if (i >= posiciones) return SUBCADENA_NO_ENCONTRADA;
+    size_t resto = buscarSubcadenaSSE2(texto + i, largo - i, capacidad - i, patron, largoPatron, sinMayusculas);
+    return resto == SUBCADENA_NO_ENCONTRADA ? resto : i + resto;
+}
+#endif
+
+#endif // BUSQUEDA_X86
+
+typedef size_t (*FuncionBuscarSubcadena)(const char*, size_t, size_t, const char*, size_t, bool);
+
+// FUNCION: Elegir la mejor version disponible en este procesador
+FuncionBuscarSubcadena elegirBuscarSubcadena() {
+#if defined(BUSQUEDA_X86) && defined(__GNUC__)
+    if (__builtin_cpu_supports("avx2")) return buscarSubcadenaAVX2;
+#endif
+#ifdef BUSQUEDA_X86
+    return buscarSubcadenaSSE2;
+#else
+    return buscarSubcadenaEscalar;
+#endif
+}
+
+const FuncionBuscarSubcadena buscarSubcadenaVectorizada = elegirBuscarSubcadena();
+
+// FUNCION: Posicion de patron en un campo char[capacidad] terminado en '\0'
+// (o SUBCADENA_NO_ENCONTRADA). Los bytes despues del '\0' no se consideran.
+inline size_t buscarEnCampo(const char* campo, size_t capacidad, const char* patron, size_t largoPatron,
+                            bool sinMayusculas) {
+    return buscarSubcadenaVectorizada(campo, strnlen(campo, capacidad), capacidad,
+                                      patron, largoPatron, sinMayusculas);
+}
+
+#endif //BUSQUEDA_SIMD_H
@@ -0,0 +1,186 @@
+#ifndef CACHE_REGISTROS_H
+#define CACHE_REGISTROS_H
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <string>
+#include "metricas.h"
+
+using namespace std;
+
+// ============================================================================
+// CACHE DE REGISTROS POR ID (LRU POR FRAGMENTOS)
+// ============================================================================
+// Guarda registros ya leidos (Paciente, Doctor...) por ID, con un limite de
+// memoria en bytes. El espacio de IDs se reparte en fragmentos con su propio
+// candado y su propia lista LRU, asi los hilos que buscan IDs distintos casi
+// nunca se esperan entre si. Al pasar el limite se descarta el registro
+// usado hace mas tiempo del fragmento.
+//
+// Quien escribe un registro en disco lo invalida (invalidarEnCache). Cada
+// invalidacion sube la generacion del fragmento: un fallo guarda lo que leyo
+// de disco solo si la generacion no cambio mientras leia, para que una
+// lectura lenta no vuelva a meter una version vieja despues de una escritura.
+
+const int FRAGMENTOS_CACHE = 16;
+const size_t BYTES_EXTRA_POR_ENTRADA = 64;     // Nodo de la lista y del mapa (aprox.)
+
+template<typename T>
+struct FragmentoCache {
+    mutex candado;
+    list<T> lru;                                        // Frente: usado mas recientemente
+    unordered_map<int, typename list<T>::iterator> posicion;
+    size_t capacidad;                                   // Registros
+    long generacion;                                    // Sube con cada invalidacion
+
+    long long aciertos;
+    long long fallos;
+    long long invalidaciones;
+    long long expulsiones;
+};
+
+template<typename T>
+struct CacheRegistros {
+    string nombre;
+    vector<FragmentoCache<T>> fragmentos;
+    size_t presupuesto;                                 // Bytes; 0 deshabilita la cache
+
+    CacheRegistros(const char* nombreCache, size_t presupuestoBytes);
+};
+
+template<typename T>
+size_t bytesPorEntradaCache() {
+    return sizeof(T) + BYTES_EXTRA_POR_ENTRADA;
+}
+
+template<typename T>
+FragmentoCache<T>& fragmentoDeID(CacheRegistros<T>& cache, int id) {
+    return cache.fragmentos[(unsigned int)id % cache.fragmentos.size()];
+}
+
+// FUNCION: Descartar registros viejos hasta entrar en la capacidad (con candado)
+template<typename T>
+void recortarFragmento(FragmentoCache<T>& f) {
+    while (f.lru.size() > f.capacidad) {
+        f.posicion.erase(f.lru.back().id);
+        f.lru.pop_back();
+        f.expulsiones++;
+    }
+}
+
+// FUNCION: Cambiar el limite de memoria de la cache (0 la deshabilita)
+template<typename T>
+void configurarCacheRegistros(CacheRegistros<T>& cache, size_t presupuestoBytes) {
+    cache.presupuesto = presupuestoBytes;
+    size_t porFragmento = presupuestoBytes / bytesPorEntradaCache<T>() / cache.fragmentos.size();
+    for (FragmentoCache<T>& f : cache.fragmentos) {
+        lock_guard<mutex> guardia(f.candado);
+        f.capacidad = porFragmento;
+        recortarFragmento(f);
+    }
+}
+
+// FUNCION: Copiar en destino el registro del ID si esta en la cache. En un
+// fallo, generacion queda con el valor a pasar luego a guardarEnCache.
+template<typename T>
+bool buscarEnCache(CacheRegistros<T>& cache, int id, T& destino, long& generacion) {
+    FragmentoCache<T>& f = fragmentoDeID(cache, id);
+    lock_guard<mutex> guardia(f.candado);
+    auto encontrado = f.posicion.find(id);
+    if (encontrado == f.posicion.end()) {
+        f.fallos++;
+        generacion = f.generacion;
+        return false;
+    }
+    f.lru.splice(f.lru.begin(), f.lru, encontrado->second);
+    f.aciertos++;
+    destino = *encontrado->second;
+    return true;
+}
+
+// FUNCION: Guardar un registro leido de disco, salvo que el ID se haya
+// invalidado despues del fallo (la generacion ya no coincide)
+template<typename T>
+void guardarEnCache(CacheRegistros<T>& cache, const T& registro, long generacion) {
+    FragmentoCache<T>& f = fragmentoDeID(cache, registro.id);
+    lock_guard<mutex> guardia(f.candado);
+    if (f.generacion != generacion || f.capacidad == 0) {
+        return;
+    }
+    auto encontrado = f.posicion.find(registro.id);
+    if (encontrado != f.posicion.end()) {
+        *encontrado->second = registro;
+        f.lru.splice(f.lru.begin(), f.lru, encontrado->second);
+        return;
+    }
+    f.lru.push_front(registro);
+    f.posicion[registro.id] = f.lru.begin();
+    recortarFragmento(f);
+}
+
+// FUNCION: Olvidar un ID (se llama despues de escribirlo en disco)
+template<typename T>
+void invalidarEnCache(CacheRegistros<T>& cache, int id) {
+    FragmentoCache<T>& f = fragmentoDeID(cache, id);
+    lock_guard<mutex> guardia(f.candado);
+    f.generacion++;
+    f.invalidaciones++;
+    auto encontrado = f.posicion.find(id);
+    if (encontrado != f.posicion.end()) {
+        f.lru.erase(encontrado->second);
+        f.posicion.erase(encontrado);
+    }
+}
+
+// FUNCION: Olvidar todo (el archivo se reemplazo: compactacion, respaldo)
+template<typename T>
+void vaciarCache(CacheRegistros<T>& cache) {
+    for (FragmentoCache<T>& f : cache.fragmentos) {
+        lock_guard<mutex> guardia(f.candado);
+        f.generacion++;
+        f.lru.clear();
+        f.posicion.clear();
+    }
+}
+
+template<typename T>
+ResumenCache leerResumenCache(CacheRegistros<T>& cache) {
+    ResumenCache r = ResumenCache();
+    r.nombre = cache.nombre;
+    r.presupuesto = (long long)cache.presupuesto;
+    for (FragmentoCache<T>& f : cache.fragmentos) {
+        lock_guard<mutex> guardia(f.candado);
+        r.aciertos += f.aciertos;
+        r.fallos += f.fallos;
+        r.invalidaciones += f.invalidaciones;
+        r.expulsiones += f.expulsiones;
+        r.entradas += (long long)f.lru.size();
+    }
+    r.bytesUsados = r.entradas * (long long)bytesPorEntradaCache<T>();
+    return r;
+}
+
+template<typename T>
+void reiniciarContadoresCache(CacheRegistros<T>& cache) {
+    for (FragmentoCache<T>& f : cache.fragmentos) {
+        lock_guard<mutex> guardia(f.candado);
+        f.aciertos = f.fallos = f.invalidaciones = f.expulsiones = 0;
+    }
+}
+
+template<typename T>
+CacheRegistros<T>::CacheRegistros(const char* nombreCache, size_t presupuestoBytes)
+    : nombre(nombreCache), fragmentos(FRAGMENTOS_CACHE) {
+    for (FragmentoCache<T>& f : fragmentos) {
+        f.capacidad = 0;
+        f.generacion = 0;
+        f.aciertos = f.fallos = f.invalidaciones = f.expulsiones = 0;
+    }
+    configurarCacheRegistros(*this, presupuestoBytes);
+    registrarCacheMetricas([this]() { return leerResumenCache(*this); },
+                           [this]() { reiniciarContadoresCache(*this); });
+}
+
+#endif //CACHE_REGISTROS_H
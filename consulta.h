@@ -0,0 +1,511 @@
+#ifndef CONSULTA_H
+#define CONSULTA_H
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <climits>
+#include <cfloat>
+#include <algorithm>
+#include "fecha.h"
+#include "busqueda_simd.h"
+
+using namespace std;
+
+// ============================================================================
+// CONSULTAS AD-HOC: LENGUAJE Y FILTROS POR COLUMNA
+// ============================================================================
+// Preguntas de una sola vez sobre los campos de una entidad, sin escribir C++:
+//
+//   pacientes donde edad > 65 y tipoSangre = O- y ultimaConsulta < hoy-365
+//   citas donde estado = Agendada y doctorID = 7 y fecha entre 2026-10-01 y 2026-10-31
+//   doctores donde especialidad ~ cardio mostrar id, apellido, costoConsulta limite 10
+//   consultas donde costo >= 100 contar
+//
+// Gramatica (palabras clave sin mayusculas):
+//   <entidad> [donde <condicion> {y <condicion>}] [mostrar campo {, campo}]
+//             [limite N] [contar]
+//   <condicion> = campo op valor | campo entre valor y valor
+//   op          = '=' '!=' '<' '<=' '>' '>='    numeros, fechas, horas...
+//                 '~' (contiene) '^' (empieza con), solo texto
+//   valor       = 42 | 10.5 | 2026-10-18 | hoy | hoy-365 | 08:30 | si | no
+//                 | palabra | "texto con espacios"
+//
+// El texto se compara sin mayusculas (letras ASCII). Cada condicion se
+// compila a un filtro sobre una sola columna; el evaluador (funciones.H)
+// aplica los filtros a un bloque de registros de una vez, achicando un
+// vector de seleccion con las posiciones que siguen vivas.
+//
+// Los campos guardados como codigo (estado, especialidad, tipoSangre) se
+// escriben como texto: al compilar, la condicion se aplica a cada texto del
+// diccionario y queda una tabla de codigos aceptados.
+
+enum TipoCampo { CAMPO_ENTERO, CAMPO_FECHA, CAMPO_HORA, CAMPO_DECIMAL, CAMPO_TEXTO, CAMPO_CARACTER, CAMPO_BOOLEANO,
+                 CAMPO_CODIGO };
+
+struct CampoConsulta {
+    const char* nombre;
+    TipoCampo tipo;
+    size_t desplazamiento;      // Dentro del registro
+    size_t capacidad;           // Bytes del campo
+    bool derivado;              // No esta en el registro: lo calcula el evaluador
+    int (*cantidadCodigos)();   // CAMPO_CODIGO: tamano del diccionario
+    string (*textoCodigo)(int); // CAMPO_CODIGO: texto de un codigo
+};
+
+struct EntidadConsulta {
+    const char* nombre;
+    vector<CampoConsulta> campos;
+    vector<int> columnasPorDefecto;
+};
+
+enum OperadorConsulta { OP_RANGO, OP_TEXTO_IGUAL, OP_TEXTO_DISTINTO, OP_CONTIENE, OP_EMPIEZA, OP_CODIGOS };
+
+// Las comparaciones numericas se guardan como un rango cerrado [desde, hasta]
+// (negado para '!='): '> 65' es [66, max] y 'entre a y b' es [a, b]. Los
+// decimales van en float, el tipo de los campos: '= 99.99' compara con el
+// mismo float que guardo el registro y '> x' empieza en el float siguiente.
+struct CondicionConsulta {
+    int campo;
+    OperadorConsulta operador;
+    long long desde, hasta;     // Enteros, fechas, horas, caracteres, booleanos
+    float desdeDecimal, hastaDecimal;
+    bool negado;
+    string texto;
+    vector<char> codigos;       // OP_CODIGOS: 1 si el codigo cumple
+};
+
+struct ConsultaAdHoc {
+    int entidad;                // Posicion en la lista de entidades
+    vector<CondicionConsulta> condiciones;
+    vector<int> columnas;
+    int limite;                 // -1 = sin limite
+    bool soloContar;
+};
+
+// ============================================================================
+// LECTURA DEL TEXTO
+// ============================================================================
+
+enum TipoSimbolo { SIMBOLO_PALABRA, SIMBOLO_TEXTO, SIMBOLO_OPERADOR, SIMBOLO_COMA, SIMBOLO_FIN };
+
+struct SimboloConsulta {
+    TipoSimbolo tipo;
+    string texto;
+};
+
+inline bool esOperadorConsulta(char c) {
+    return c == '=' || c == '!' || c == '<' || c == '>' || c == '~' || c == '^';
+}
+
+// FUNCION: Partir el texto en palabras, textos entre comillas, operadores y comas
+bool leerSimbolosConsulta(const char* texto, vector<SimboloConsulta>& simbolos, string& error) {
+    simbolos.clear();
+    const char* p = texto;
+    while (true) {
+        while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+        if (*p == '\0') break;
+
+        if (*p == '"') {
+            const char* fin = strchr(p + 1, '"');
+            if (fin == nullptr) {
+                error = "Falta cerrar las comillas";
+                return false;
+            }
+            simbolos.push_back({SIMBOLO_TEXTO, string(p + 1, fin)});
+            p = fin + 1;
+        } else if (*p == ',') {
+            simbolos.push_back({SIMBOLO_COMA, ","});
+            p++;
+        } else if (esOperadorConsulta(*p)) {
+            int largo = (p[1] == '=' && (*p == '!' || *p == '<' || *p == '>')) ? 2 : 1;
+            string op(p, largo);
+            if (op == "!") {
+                error = "Operador invalido: !";
+                return false;
+            }
+            simbolos.push_back({SIMBOLO_OPERADOR, op});
+            p += largo;
+        } else {
+            const char* inicio = p;
+            while (*p != '\0' && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n' &&
+                   *p != ',' && *p != '"' && !esOperadorConsulta(*p)) {
+                p++;
+            }
+            simbolos.push_back({SIMBOLO_PALABRA, string(inicio, p)});
+        }
+    }
+    simbolos.push_back({SIMBOLO_FIN, ""});
+    return true;
+}
+
+// true si a y b son iguales sin mayusculas (letras ASCII)
+inline bool mismaPalabra(const string& a, const char* b) {
+    size_t largo = strlen(b);
+    return a.size() == largo && coincideEn(a.c_str(), b, largo, true);
+}
+
+int buscarCampoConsulta(const EntidadConsulta& entidad, const string& nombre) {
+    for (size_t i = 0; i < entidad.campos.size(); i++) {
+        if (mismaPalabra(nombre, entidad.campos[i].nombre)) return (int)i;
+    }
+    return -1;
+}
+
+// FUNCION: Convertir un valor al tipo del campo (enteros en entero, decimales en decimal)
+bool leerValorConsulta(const CampoConsulta& campo, const SimboloConsulta& s, long long& entero,
+                       float& decimal, string& error) {
+    if (s.tipo != SIMBOLO_PALABRA && s.tipo != SIMBOLO_TEXTO) {
+        error = string("Falta el valor para ") + campo.nombre;
+        return false;
+    }
+    const char* t = s.texto.c_str();
+    char* fin = nullptr;
+
+    switch (campo.tipo) {
+        case CAMPO_ENTERO:
+            entero = strtoll(t, &fin, 10);
+            if (fin != t && *fin == '\0') return true;
+            break;
+        case CAMPO_DECIMAL:
+            decimal = strtof(t, &fin);
+            if (fin != t && *fin == '\0') return true;
+            break;
+        case CAMPO_FECHA:
+            // hoy, hoy-N, hoy+N o YYYY-MM-DD
+            if (s.texto.size() >= 3 && coincideEn(t, "hoy", 3, true)) {
+                entero = fechaHoy();
+                if (t[3] == '\0') return true;
+                long dias = strtol(t + 3, &fin, 10);
+                if ((t[3] == '-' || t[3] == '+') && fin != t + 4 && *fin == '\0') {
+                    entero += dias;
+                    return true;
+                }
+                break;
+            }
+            entero = parsearFecha(t);
+            if (entero != FECHA_INVALIDA) return true;
+            break;
+        case CAMPO_HORA:
+            entero = parsearHora(t);
+            if (entero != HORA_INVALIDA) return true;
+            break;
+        case CAMPO_CARACTER:
+            if (s.texto.size() == 1) {
+                entero = (unsigned char)t[0];
+                entero = (entero >= 'a' && entero <= 'z') ? entero - 32 : entero;
+                return true;
+            }
+            break;
+        case CAMPO_BOOLEANO:
+            if (mismaPalabra(s.texto, "si") || mismaPalabra(s.texto, "true") || s.texto == "1") {
+                entero = 1;
+                return true;
+            }
+            if (mismaPalabra(s.texto, "no") || mismaPalabra(s.texto, "false") || s.texto == "0") {
+                entero = 0;
+                return true;
+            }
+            break;
+        case CAMPO_TEXTO:
+        case CAMPO_CODIGO:
+            return true;
+    }
+    error = "Valor invalido para " + string(campo.nombre) + ": " + s.texto;
+    return false;
+}
+
+// FUNCION: Armar el rango [desde, hasta] de una comparacion numerica
+bool compilarComparacion(const CampoConsulta& campo, const string& op, long long valor, float valorDecimal,
+                         CondicionConsulta& c) {
+    c.operador = OP_RANGO;
+    c.negado = false;
+    c.desde = LLONG_MIN;
+    c.hasta = LLONG_MAX;
+    c.desdeDecimal = -HUGE_VALF;
+    c.hastaDecimal = HUGE_VALF;
+    bool decimal = campo.tipo == CAMPO_DECIMAL;
+
+    if (op == "=" || op == "!=") {
+        c.desde = c.hasta = valor;
+        c.desdeDecimal = c.hastaDecimal = valorDecimal;
+        c.negado = op == "!=";
+    } else if (op == "<") {
+        c.hasta = valor - 1;
+        c.hastaDecimal = nextafterf(valorDecimal, -HUGE_VALF);
+    } else if (op == "<=") {
+        c.hasta = valor;
+        c.hastaDecimal = valorDecimal;
+    } else if (op == ">") {
+        c.desde = valor + 1;
+        c.desdeDecimal = nextafterf(valorDecimal, HUGE_VALF);
+    } else if (op == ">=") {
+        c.desde = valor;
+        c.desdeDecimal = valorDecimal;
+    } else {
+        return false;
+    }
+    if (decimal) {
+        c.desde = LLONG_MIN;
+        c.hasta = LLONG_MAX;
+    }
+    return true;
+}
+
+// Compara el campo (hasta capacidad bytes, terminado en '\0') con el texto
+inline bool textoIgualEnCampo(const char* campo, size_t capacidad, const string& texto, bool soloPrefijo) {
+    size_t largo = texto.size();
+    if (largo > capacidad) return false;
+    if (!coincideEn(campo, texto.c_str(), largo, true)) return false;
+    return soloPrefijo || largo == capacidad || campo[largo] == '\0';
+}
+
+// true si el campo cumple una condicion de texto
+inline bool cumpleTexto(const char* campo, size_t capacidad, OperadorConsulta operador, const string& texto) {
+    switch (operador) {
+        case OP_TEXTO_IGUAL:    return textoIgualEnCampo(campo, capacidad, texto, false);
+        case OP_TEXTO_DISTINTO: return !textoIgualEnCampo(campo, capacidad, texto, false);
+        case OP_EMPIEZA:        return textoIgualEnCampo(campo, capacidad, texto, true);
+        default:
+            return texto.empty() ||
+                   buscarEnCampo(campo, capacidad, texto.c_str(), texto.size(), true) != SUBCADENA_NO_ENCONTRADA;
+    }
+}
+
+// FUNCION: Pasar una condicion de texto sobre un campo codificado a la tabla
+// de codigos que la cumplen
+void compilarCodigos(const CampoConsulta& campo, CondicionConsulta& c) {
+    int cantidad = campo.cantidadCodigos();
+    c.codigos.assign(cantidad, 0);
+    for (int codigo = 0; codigo < cantidad; codigo++) {
+        string texto = campo.textoCodigo(codigo);
+        c.codigos[codigo] = cumpleTexto(texto.c_str(), texto.size() + 1, c.operador, c.texto);
+    }
+    c.operador = OP_CODIGOS;
+}
+
+// FUNCION: Leer una condicion (campo op valor | campo entre a y b)
+bool leerCondicionConsulta(const EntidadConsulta& entidad, const vector<SimboloConsulta>& s, size_t& i,
+                           CondicionConsulta& c, string& error) {
+    if (s[i].tipo != SIMBOLO_PALABRA) {
+        error = "Se esperaba un campo";
+        return false;
+    }
+    c.campo = buscarCampoConsulta(entidad, s[i].texto);
+    if (c.campo == -1) {
+        error = "Campo desconocido en " + string(entidad.nombre) + ": " + s[i].texto;
+        return false;
+    }
+    const CampoConsulta& campo = entidad.campos[c.campo];
+    i++;
+
+    long long valor = 0, valorHasta = 0;
+    float decimal = 0, decimalHasta = 0;
+
+    if (s[i].tipo == SIMBOLO_PALABRA && mismaPalabra(s[i].texto, "entre")) {
+        if (campo.tipo == CAMPO_TEXTO || campo.tipo == CAMPO_CODIGO) {
+            error = string("'entre' no se aplica a texto: ") + campo.nombre;
+            return false;
+        }
+        if (!leerValorConsulta(campo, s[i + 1], valor, decimal, error)) return false;
+        if (s[i + 2].tipo != SIMBOLO_PALABRA || !mismaPalabra(s[i + 2].texto, "y")) {
+            error = "Falta 'y' en 'entre'";
+            return false;
+        }
+        if (!leerValorConsulta(campo, s[i + 3], valorHasta, decimalHasta, error)) return false;
+        compilarComparacion(campo, ">=", valor, decimal, c);
+        CondicionConsulta hasta;
+        compilarComparacion(campo, "<=", valorHasta, decimalHasta, hasta);
+        c.hasta = hasta.hasta;
+        c.hastaDecimal = hasta.hastaDecimal;
+        i += 4;
+        return true;
+    }
+
+    if (s[i].tipo != SIMBOLO_OPERADOR) {
+        error = string("Falta el operador despues de ") + campo.nombre;
+        return false;
+    }
+    string op = s[i].texto;
+    if (!leerValorConsulta(campo, s[i + 1], valor, decimal, error)) return false;
+    i += 2;
+
+    if (campo.tipo == CAMPO_TEXTO || campo.tipo == CAMPO_CODIGO) {
+        c.texto = s[i - 1].texto;
+        c.negado = false;
+        if (op == "=") c.operador = OP_TEXTO_IGUAL;
+        else if (op == "!=") c.operador = OP_TEXTO_DISTINTO;
+        else if (op == "~") c.operador = OP_CONTIENE;
+        else if (op == "^") c.operador = OP_EMPIEZA;
+        else {
+            error = "Operador " + op + " no se aplica a texto: " + campo.nombre;
+            return false;
+        }
+        if (campo.tipo == CAMPO_CODIGO) {
+            compilarCodigos(campo, c);
+        }
+        return true;
+    }
+    if (!compilarComparacion(campo, op, valor, decimal, c)) {
+        error = "Operador " + op + " solo se aplica a texto: " + campo.nombre;
+        return false;
+    }
+    return true;
+}
+
+// FUNCION: Compilar el texto de una consulta (false con el motivo en error)
+bool parsearConsulta(const char* texto, const vector<EntidadConsulta>& entidades, ConsultaAdHoc& consulta,
+                     string& error) {
+    vector<SimboloConsulta> s;
+    if (!leerSimbolosConsulta(texto, s, error)) return false;
+
+    consulta = ConsultaAdHoc();
+    consulta.entidad = -1;
+    consulta.limite = -1;
+    consulta.soloContar = false;
+    for (size_t e = 0; e < entidades.size() && s[0].tipo == SIMBOLO_PALABRA; e++) {
+        if (mismaPalabra(s[0].texto, entidades[e].nombre)) consulta.entidad = (int)e;
+    }
+    if (consulta.entidad == -1) {
+        error = "La consulta empieza con la entidad:";
+        for (const EntidadConsulta& e : entidades) error += string(" ") + e.nombre;
+        return false;
+    }
+    const EntidadConsulta& entidad = entidades[consulta.entidad];
+
+    size_t i = 1;
+    if (s[i].tipo == SIMBOLO_PALABRA && mismaPalabra(s[i].texto, "donde")) {
+        do {
+            i++;
+            CondicionConsulta c;
+            if (!leerCondicionConsulta(entidad, s, i, c, error)) return false;
+            consulta.condiciones.push_back(c);
+        } while (s[i].tipo == SIMBOLO_PALABRA && mismaPalabra(s[i].texto, "y"));
+    }
+
+    while (s[i].tipo != SIMBOLO_FIN) {
+        if (s[i].tipo == SIMBOLO_PALABRA && mismaPalabra(s[i].texto, "mostrar")) {
+            do {
+                i++;
+                int campo = s[i].tipo == SIMBOLO_PALABRA ? buscarCampoConsulta(entidad, s[i].texto) : -1;
+                if (campo == -1) {
+                    error = "Campo desconocido en 'mostrar': " + s[i].texto;
+                    return false;
+                }
+                consulta.columnas.push_back(campo);
+                i++;
+            } while (s[i].tipo == SIMBOLO_COMA);
+        } else if (s[i].tipo == SIMBOLO_PALABRA && mismaPalabra(s[i].texto, "limite")) {
+            char* fin = nullptr;
+            consulta.limite = s[i + 1].tipo == SIMBOLO_PALABRA ? (int)strtol(s[i + 1].texto.c_str(), &fin, 10) : -1;
+            if (fin == nullptr || *fin != '\0' || consulta.limite < 0) {
+                error = "'limite' necesita un numero";
+                return false;
+            }
+            i += 2;
+        } else if (s[i].tipo == SIMBOLO_PALABRA && mismaPalabra(s[i].texto, "contar")) {
+            consulta.soloContar = true;
+            i++;
+        } else {
+            error = "No se entiende: " + s[i].texto;
+            return false;
+        }
+    }
+
+    if (consulta.columnas.empty()) consulta.columnas = entidad.columnasPorDefecto;
+    return true;
+}
+
+// ============================================================================
+// FILTROS POR COLUMNA
+// ============================================================================
+// Cada filtro recorre una sola columna de un bloque de registros (base apunta
+// al campo del primer registro y paso es el tamano del registro) y deja en
+// seleccion solo las posiciones que cumplen. La compactacion no tiene saltos:
+// se escribe siempre y el indice de salida avanza segun el resultado.
+
+template<typename V, typename L>
+void filtrarRango(const char* base, size_t paso, vector<int>& seleccion, L desde, L hasta, bool negado) {
+    size_t salida = 0;
+    for (size_t k = 0; k < seleccion.size(); k++) {
+        int i = seleccion[k];
+        V valor;
+        memcpy(&valor, base + (size_t)i * paso, sizeof(V));
+        bool dentro = (L)valor >= desde && (L)valor <= hasta;
+        seleccion[salida] = i;
+        salida += dentro != negado;
+    }
+    seleccion.resize(salida);
+}
+
+void filtrarTexto(const char* base, size_t paso, size_t capacidad, vector<int>& seleccion,
+                  OperadorConsulta operador, const string& texto) {
+    size_t salida = 0;
+    for (size_t k = 0; k < seleccion.size(); k++) {
+        int i = seleccion[k];
+        bool cumple = cumpleTexto(base + (size_t)i * paso, capacidad, operador, texto);
+        seleccion[salida] = i;
+        salida += cumple;
+    }
+    seleccion.resize(salida);
+}
+
+// Un codigo fuera de la tabla no cumple nada
+template<typename V>
+void filtrarCodigos(const char* base, size_t paso, vector<int>& seleccion, const vector<char>& codigos) {
+    size_t salida = 0;
+    for (size_t k = 0; k < seleccion.size(); k++) {
+        int i = seleccion[k];
+        V valor;
+        memcpy(&valor, base + (size_t)i * paso, sizeof(V));
+        seleccion[salida] = i;
+        salida += valor < codigos.size() && codigos[valor];
+    }
+    seleccion.resize(salida);
+}
+
+// FUNCION: Aplicar una condicion a la columna de su campo
+void filtrarColumna(const CampoConsulta& campo, const CondicionConsulta& c, const char* base, size_t paso,
+                    vector<int>& seleccion) {
+    switch (campo.tipo) {
+        case CAMPO_ENTERO:
+        case CAMPO_FECHA:
+            filtrarRango<int>(base, paso, seleccion, c.desde, c.hasta, c.negado);
+            break;
+        case CAMPO_HORA:
+            filtrarRango<short>(base, paso, seleccion, c.desde, c.hasta, c.negado);
+            break;
+        case CAMPO_CARACTER:
+            filtrarRango<unsigned char>(base, paso, seleccion, c.desde, c.hasta, c.negado);
+            break;
+        case CAMPO_BOOLEANO:
+            filtrarRango<bool>(base, paso, seleccion, c.desde, c.hasta, c.negado);
+            break;
+        case CAMPO_DECIMAL:
+            filtrarRango<float>(base, paso, seleccion, c.desdeDecimal, c.hastaDecimal, c.negado);
+            break;
+        case CAMPO_TEXTO:
+            filtrarTexto(base, paso, campo.capacidad, seleccion, c.operador, c.texto);
+            break;
+        case CAMPO_CODIGO:
+            if (campo.capacidad == sizeof(unsigned short)) {
+                filtrarCodigos<unsigned short>(base, paso, seleccion, c.codigos);
+            } else {
+                filtrarCodigos<unsigned char>(base, paso, seleccion, c.codigos);
+            }
+            break;
+    }
+}
+
+// Costo relativo de una condicion: primero las numericas, al final '~'
+int costoCondicion(const CondicionConsulta& c) {
+    return c.operador == OP_RANGO || c.operador == OP_CODIGOS ? 0 : c.operador == OP_CONTIENE ? 2 : 1;
+}
+
+bool menorCostoCondicion(const CondicionConsulta& a, const CondicionConsulta& b) {
+    return costoCondicion(a) < costoCondicion(b);
+}
+
+#endif //CONSULTA_H
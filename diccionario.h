@@ -0,0 +1,213 @@
+#ifndef DICCIONARIO_H
+#define DICCIONARIO_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstring>
+#include <cstdio>
+#include <cctype>
+#include "estructuras.h.H"
+#include "texto.h"
+
+using namespace std;
+
+// ============================================================================
+// DICCIONARIOS DE CODIGOS
+// ============================================================================
+// Los campos que repiten unos pocos valores guardan un codigo chico en lugar
+// del texto: el registro se achica, comparar es comparar enteros y los
+// reportes agrupan indexando un arreglo por codigo.
+//
+// - Estado de la cita: enum EstadoCita (estructuras.h.H), valores fijos.
+// - Tipo de sangre: posicion en TIPOS_SANGRE, valores fijos.
+// - Especialidad: diccionario que crece; el codigo es el orden en que
+//   aparecio cada especialidad y no cambia. Se guarda en diccionarios.bin.
+//
+// Dos textos que solo difieren en mayusculas o acentos son el mismo valor
+// (clave de texto.h); se conserva como se escribio la primera vez.
+//
+// En disco: [CabeceraDiccionarios] y por diccionario [cantidad] seguido de
+// cada texto como [largo (1 byte)][caracteres].
+
+const int VERSION_DICCIONARIOS = 1;
+const int LARGO_MAXIMO_DICCIONARIO = 255;
+const int CODIGOS_MAXIMOS_DICCIONARIO = 65535;     // Entra en unsigned short
+
+// Diccionarios de diccionarios.bin, en este orden
+const int DICCIONARIO_ESPECIALIDADES = 0;
+const int CANTIDAD_DICCIONARIOS = 1;
+
+struct CabeceraDiccionarios {
+    int version;
+    int cantidad;
+};
+
+struct Diccionario {
+    vector<string> textos;                  // Codigo -> texto
+    unordered_map<string, int> codigos;     // Clave normalizada -> codigo
+};
+
+// FUNCION: Clave de un texto para el diccionario (sin mayusculas ni acentos)
+string claveDiccionario(const char* texto) {
+    char clave[LARGO_MAXIMO_DICCIONARIO + 1];
+    normalizarTexto(texto, clave, LARGO_MAXIMO_DICCIONARIO);
+    return clave;
+}
+
+// Codigo de un texto (-1 si no esta)
+int buscarEnDiccionario(const Diccionario& d, const char* texto) {
+    auto encontrado = d.codigos.find(claveDiccionario(texto));
+    return encontrado == d.codigos.end() ? -1 : encontrado->second;
+}
+
+// FUNCION: Codigo de un texto, agregandolo al final si no estaba (-1 si el
+// diccionario esta lleno). nuevo queda en true si se agrego.
+int agregarADiccionario(Diccionario& d, const char* texto, bool& nuevo) {
+    string clave = claveDiccionario(texto);
+    auto encontrado = d.codigos.find(clave);
+    nuevo = encontrado == d.codigos.end();
+    if (!nuevo) {
+        return encontrado->second;
+    }
+    if ((int)d.textos.size() >= CODIGOS_MAXIMOS_DICCIONARIO) {
+        nuevo = false;
+        return -1;
+    }
+    int codigo = (int)d.textos.size();
+    d.textos.push_back(string(texto).substr(0, LARGO_MAXIMO_DICCIONARIO));
+    d.codigos[clave] = codigo;
+    return codigo;
+}
+
+// Texto de un codigo ("?" si no esta en el diccionario)
+string textoDeDiccionario(const Diccionario& d, int codigo) {
+    return codigo >= 0 && codigo < (int)d.textos.size() ? d.textos[codigo] : "?";
+}
+
+// FUNCION: Escribir todos los diccionarios. Se escribe en un temporal y se
+// renombra: un corte a mitad deja el archivo anterior.
+bool escribirDiccionarios(const char* nombreArchivo, const vector<Diccionario>& diccionarios) {
+    string temporal = string(nombreArchivo) + ".tmp";
+    ofstream archivo(temporal, ios::binary | ios::trunc);
+    if (!archivo.is_open()) {
+        return false;
+    }
+
+    CabeceraDiccionarios cabecera = {VERSION_DICCIONARIOS, (int)diccionarios.size()};
+    archivo.write((const char*)&cabecera, sizeof(CabeceraDiccionarios));
+    for (const Diccionario& d : diccionarios) {
+        int cantidad = (int)d.textos.size();
+        archivo.write((const char*)&cantidad, sizeof(int));
+        for (const string& texto : d.textos) {
+            unsigned char largo = (unsigned char)texto.size();
+            archivo.write((const char*)&largo, 1);
+            archivo.write(texto.data(), largo);
+        }
+    }
+    archivo.close();
+    if (!archivo) {
+        remove(temporal.c_str());
+        return false;
+    }
+
+    remove(nombreArchivo);
+    return rename(temporal.c_str(), nombreArchivo) == 0;
+}
+
+// FUNCION: Leer los diccionarios (false si el archivo no existe o esta
+// danado). Los que falten al final quedan vacios.
+bool leerDiccionarios(const char* nombreArchivo, vector<Diccionario>& diccionarios) {
+    diccionarios.assign(CANTIDAD_DICCIONARIOS, Diccionario());
+    ifstream archivo(nombreArchivo, ios::binary);
+    if (!archivo.is_open()) {
+        return false;
+    }
+
+    CabeceraDiccionarios cabecera;
+    archivo.read((char*)&cabecera, sizeof(CabeceraDiccionarios));
+    if (!archivo || cabecera.version != VERSION_DICCIONARIOS || cabecera.cantidad < 0) {
+        return false;
+    }
+
+    char texto[LARGO_MAXIMO_DICCIONARIO + 1];
+    for (int i = 0; i < cabecera.cantidad; i++) {
+        int cantidad;
+        archivo.read((char*)&cantidad, sizeof(int));
+        if (!archivo || cantidad < 0 || cantidad > CODIGOS_MAXIMOS_DICCIONARIO) {
+            return false;
+        }
+        Diccionario d;
+        for (int codigo = 0; codigo < cantidad; codigo++) {
+            unsigned char largo;
+            archivo.read((char*)&largo, 1);
+            archivo.read(texto, largo);
+            if (!archivo) {
+                return false;
+            }
+            texto[largo] = '\0';
+            d.textos.push_back(texto);
+            d.codigos[claveDiccionario(texto)] = codigo;
+        }
+        if (i < CANTIDAD_DICCIONARIOS) {
+            diccionarios[i] = d;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// VALORES FIJOS: TIPO DE SANGRE Y ESTADO DE LA CITA
+// ============================================================================
+
+const int CANTIDAD_TIPOS_SANGRE = 8;
+const char* TIPOS_SANGRE[CANTIDAD_TIPOS_SANGRE] = {"A+", "A-", "B+", "B-", "AB+", "AB-", "O+", "O-"};
+const unsigned char TIPO_SANGRE_DESCONOCIDO = CANTIDAD_TIPOS_SANGRE;
+
+// FUNCION: Posicion de un tipo de sangre en TIPOS_SANGRE (sin distinguir
+// mayusculas); TIPO_SANGRE_DESCONOCIDO si no es ninguno
+int codigoTipoSangre(const char* tipo, size_t capacidad) {
+    for (int i = 0; i < CANTIDAD_TIPOS_SANGRE; i++) {
+        size_t k = 0;
+        while (k < capacidad && tipo[k] != '\0' && TIPOS_SANGRE[i][k] != '\0' &&
+               toupper((unsigned char)tipo[k]) == TIPOS_SANGRE[i][k]) {
+            k++;
+        }
+        if (TIPOS_SANGRE[i][k] == '\0' && (k == capacidad || tipo[k] == '\0')) return i;
+    }
+    return TIPO_SANGRE_DESCONOCIDO;
+}
+
+const char* textoTipoSangre(int codigo) {
+    return codigo >= 0 && codigo < CANTIDAD_TIPOS_SANGRE ? TIPOS_SANGRE[codigo] : "?";
+}
+
+const int CANTIDAD_ESTADOS_CITA = 3;
+const char* ESTADOS_CITA[CANTIDAD_ESTADOS_CITA] = {"Agendada", "Atendida", "Cancelada"};
+
+const char* textoEstadoCita(EstadoCita estado) {
+    return estado < CANTIDAD_ESTADOS_CITA ? ESTADOS_CITA[estado] : "?";
+}
+
+// FUNCION: Estado de un texto (sin distinguir mayusculas); false si no es ninguno
+bool estadoCitaDeTexto(const char* texto, EstadoCita& estado) {
+    for (int i = 0; i < CANTIDAD_ESTADOS_CITA; i++) {
+        size_t k = 0;
+        while (texto[k] != '\0' && toupper((unsigned char)texto[k]) == toupper((unsigned char)ESTADOS_CITA[i][k])) {
+            k++;
+        }
+        if (texto[k] == '\0' && ESTADOS_CITA[i][k] == '\0') {
+            estado = (EstadoCita)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Agendada -> Atendida | Cancelada; los otros dos estados son finales
+bool transicionCitaValida(EstadoCita desde, EstadoCita hasta) {
+    return desde == CITA_AGENDADA && (hasta == CITA_ATENDIDA || hasta == CITA_CANCELADA);
+}
+
+#endif //DICCIONARIO_H
@@ -0,0 +1,163 @@
+#ifndef FECHA_H
+#define FECHA_H
+
+#include <ctime>
+#include <string>
+#include <type_traits>
+
+using namespace std;
+
+// ============================================================================
+// FECHAS Y HORAS COMPACTAS
+// ============================================================================
+// Los registros guardan la fecha como dias desde 1970-01-01 (int) y la hora
+// como minutos desde la medianoche (short). Comparar, ordenar o restar
+// fechas es una operacion entera; el texto YYYY-MM-DD / HH:MM solo se usa
+// al leer de la consola y al mostrar.
+//
+// Las conversiones usan el algoritmo civil de H. Hinnant y son constexpr:
+// FECHA("2026-10-20") se resuelve en tiempo de compilacion.
+
+typedef int Fecha;                  // Dias desde 1970-01-01
+typedef short Hora;                 // Minutos desde 00:00
+
+const Fecha FECHA_INVALIDA = -2147483647 - 1;
+const Hora HORA_INVALIDA = -1;
+const int MINUTOS_POR_DIA = 24 * 60;
+
+constexpr bool esBisiesto(int anio) {
+    return anio % 4 == 0 && (anio % 100 != 0 || anio % 400 == 0);
+}
+
+constexpr int diasDelMes(int anio, int mes) {
+    return mes == 2 ? (esBisiesto(anio) ? 29 : 28) :
+           (mes == 4 || mes == 6 || mes == 9 || mes == 11) ? 30 : 31;
+}
+
+// FUNCION: Dias desde 1970-01-01 de una fecha civil
+constexpr Fecha diasDesdeCivil(int anio, int mes, int dia) {
+    anio -= mes <= 2;
+    int era = (anio >= 0 ? anio : anio - 399) / 400;
+    int yoe = anio - era * 400;
+    int doy = (153 * (mes + (mes > 2 ? -3 : 9)) + 2) / 5 + dia - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// FUNCION: Fecha civil de un numero de dias desde 1970-01-01
+constexpr void civilDesdeDias(Fecha dias, int& anio, int& mes, int& dia) {
+    dias += 719468;
+    int era = (dias >= 0 ? dias : dias - 146096) / 146097;
+    unsigned doe = (unsigned)(dias - era * 146097);
+    unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    unsigned mp = (5 * doy + 2) / 153;
+    dia = (int)(doy - (153 * mp + 2) / 5 + 1);
+    mes = (int)(mp < 10 ? mp + 3 : mp - 9);
+    anio = (int)yoe + era * 400 + (mes <= 2);
+}
+
+// 0 = lunes ... 6 = domingo (1970-01-01 fue jueves)
+constexpr int diaDeSemana(Fecha fecha) {
+    return ((fecha % 7) + 7 + 3) % 7;
+}
+
+const char* NOMBRES_DIA_SEMANA[] = {
+    "Lunes", "Martes", "Miercoles", "Jueves", "Viernes", "Sabado", "Domingo"
+};
+
+constexpr bool leerDigitos(const char* texto, int cantidad, int& valor) {
+    valor = 0;
+    for (int i = 0; i < cantidad; i++) {
+        if (texto[i] < '0' || texto[i] > '9') return false;
+        valor = valor * 10 + (texto[i] - '0');
+    }
+    return true;
+}
+
+// FUNCION: Convertir "YYYY-MM-DD" (exacto, anio 1900..2100) a Fecha
+constexpr Fecha parsearFecha(const char* texto) {
+    int anio = 0, mes = 0, dia = 0;
+    if (!leerDigitos(texto, 4, anio) || texto[4] != '-' ||
+        !leerDigitos(texto + 5, 2, mes) || texto[7] != '-' ||
+        !leerDigitos(texto + 8, 2, dia) || texto[10] != '\0') {
+        return FECHA_INVALIDA;
+    }
+    if (anio < 1900 || anio > 2100 || mes < 1 || mes > 12) return FECHA_INVALIDA;
+    if (dia < 1 || dia > diasDelMes(anio, mes)) return FECHA_INVALIDA;
+    return diasDesdeCivil(anio, mes, dia);
+}
+
+// FUNCION: Convertir "HH:MM" (exacto) a Hora
+constexpr Hora parsearHora(const char* texto) {
+    int horas = 0, minutos = 0;
+    if (!leerDigitos(texto, 2, horas) || texto[2] != ':' ||
+        !leerDigitos(texto + 3, 2, minutos) || texto[5] != '\0') {
+        return HORA_INVALIDA;
+    }
+    if (horas > 23 || minutos > 59) return HORA_INVALIDA;
+    return (Hora)(horas * 60 + minutos);
+}
+
+#define FECHA(texto) (integral_constant<Fecha, parsearFecha(texto)>::value)
+
+// FUNCION: Escribir YYYY-MM-DD en destino (11 bytes con el '\0')
+constexpr void formatearFecha(Fecha fecha, char* destino) {
+    int anio = 0, mes = 0, dia = 0;
+    civilDesdeDias(fecha, anio, mes, dia);
+    int valores[3] = {anio, mes, dia};
+    int anchos[3] = {4, 2, 2};
+    int p = 0;
+    for (int campo = 0; campo < 3; campo++) {
+        if (campo > 0) destino[p++] = '-';
+        int v = valores[campo] < 0 ? 0 : valores[campo];
+        for (int i = anchos[campo] - 1; i >= 0; i--) {
+            destino[p + i] = (char)('0' + v % 10);
+            v /= 10;
+        }
+        p += anchos[campo];
+    }
+    destino[p] = '\0';
+}
+
+// FUNCION: Escribir HH:MM en destino (6 bytes con el '\0')
+constexpr void formatearHora(Hora hora, char* destino) {
+    int horas = hora / 60, minutos = hora % 60;
+    destino[0] = (char)('0' + horas / 10);
+    destino[1] = (char)('0' + horas % 10);
+    destino[2] = ':';
+    destino[3] = (char)('0' + minutos / 10);
+    destino[4] = (char)('0' + minutos % 10);
+    destino[5] = '\0';
+}
+
+// Para mostrar con cout
+string textoFecha(Fecha fecha) {
+    if (fecha == FECHA_INVALIDA) return "----------";
+    char texto[11];
+    formatearFecha(fecha, texto);
+    return texto;
+}
+
+string textoHora(Hora hora) {
+    if (hora < 0 || hora >= MINUTOS_POR_DIA) return "--:--";
+    char texto[6];
+    formatearHora(hora, texto);
+    return texto;
+}
+
+// FUNCION: Fecha local de hoy
+Fecha fechaHoy() {
+    time_t ahora = time(0);
+    tm local = *localtime(&ahora);
+    return diasDesdeCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday);
+}
+
+// FUNCION: Hora local actual
+Hora horaActual() {
+    time_t ahora = time(0);
+    tm local = *localtime(&ahora);
+    return (Hora)(local.tm_hour * 60 + local.tm_min);
+}
+
+#endif //FECHA_H
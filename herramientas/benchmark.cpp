@@ -0,0 +1,390 @@
+// ============================================================================
+// BENCHMARK DE OPERACIONES DE ALMACENAMIENTO (funciones.H)
+// ============================================================================
+// Compilar:  g++ -std=c++17 -O2 -pthread -o benchmark herramientas/benchmark.cpp
+// Uso:       benchmark [--tamanos 1000,10000] [--iteraciones 20]
+//                      [--tiempo-max 10] [--semilla 42]
+//                      [--operaciones buscarPacientePorID,...]
+//                      [--directorio bench_datos] [--salida resultados.json]
+//                      [--cache-kb 8192,1024]
+//
+// Para cada tamano genera un conjunto de datos nuevo en su propio
+// directorio y mide cada operacion: percentiles de latencia, throughput,
+// bytes leidos/escritos y llamadas al sistema (via /proc/self/io en Linux),
+// mas los registros leidos segun las metricas internas (metricas.h).
+// --cache-kb fija el limite de las caches de pacientes y doctores (0,0 las
+// deshabilita, para medir el acceso a disco).
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <filesystem>
+#include "../funciones.H"
+#include "generador.h"
+
+using namespace std;
+
+// ============================================================================
+// MEDICION
+// ============================================================================
+
+struct ContadoresIO {
+    long long bytesLeidos;
+    long long bytesEscritos;
+    long long llamadasLectura;
+    long long llamadasEscritura;
+};
+
+struct ResultadoOperacion {
+    string operacion;
+    int registros;
+    int iteraciones;
+    double segundosTotales;
+    double p50, p90, p99, maximo, promedio;   // Microsegundos
+    ContadoresIO io;
+    long long registrosLeidos;                // Segun metricas.h (-1 si no aplica)
+};
+
+// Descarta toda la salida de las funciones del sistema durante la medicion
+struct BufferNulo : streambuf {
+    int overflow(int c) { return c; }
+};
+
+// FUNCION: Leer contadores de E/S del proceso
+ContadoresIO leerContadoresIO() {
+    ContadoresIO c = {0, 0, 0, 0};
+#ifdef __linux__
+    ifstream archivo("/proc/self/io");
+    string clave;
+    long long valor;
+    while (archivo >> clave >> valor) {
+        if (clave == "rchar:") c.bytesLeidos = valor;
+        else if (clave == "wchar:") c.bytesEscritos = valor;
+        else if (clave == "syscr:") c.llamadasLectura = valor;
+        else if (clave == "syscw:") c.llamadasEscritura = valor;
+    }
+#endif
+    return c;
+}
+
+// FUNCION: Registros leidos por una operacion segun sus metricas internas
+long long registrosLeidosMetrica(const string& nombre) {
+    for (int op = 0; op < CANT_OPERACIONES_METRICA; op++) {
+        if (nombre == NOMBRES_METRICA[op]) {
+            return leerMetricas()[op].registrosLeidos;
+        }
+    }
+    return -1;
+}
+
+// FUNCION: Percentil sobre un vector ya ordenado
+double percentil(const vector<double>& ordenado, double p) {
+    if (ordenado.empty()) return 0;
+    size_t indice = (size_t)(p * (ordenado.size() - 1) + 0.5);
+    return ordenado[indice];
+}
+
+// FUNCION: Ejecutar una operacion varias veces y medirla
+ResultadoOperacion medirOperacion(const string& nombre, int registros, int iteraciones,
+                                  double tiempoMaximo, const function<void(int)>& operacion) {
+    BufferNulo nulo;
+    streambuf* salidaOriginal = cout.rdbuf(&nulo);
+
+    vector<double> latencias;
+    long long registrosAntes = registrosLeidosMetrica(nombre);
+    ContadoresIO antes = leerContadoresIO();
+    auto inicio = chrono::steady_clock::now();
+
+    for (int i = 0; i < iteraciones; i++) {
+        auto t0 = chrono::steady_clock::now();
+        operacion(i);
+        auto t1 = chrono::steady_clock::now();
+        latencias.push_back(chrono::duration<double, micro>(t1 - t0).count());
+
+        if (chrono::duration<double>(t1 - inicio).count() > tiempoMaximo) {
+            break;
+        }
+    }
+
+    double total = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    ContadoresIO despues = leerContadoresIO();
+    long long registrosDespues = registrosLeidosMetrica(nombre);
+    cout.rdbuf(salidaOriginal);
+
+    ResultadoOperacion r;
+    r.operacion = nombre;
+    r.registros = registros;
+    r.iteraciones = (int)latencias.size();
+    r.segundosTotales = total;
+
+    sort(latencias.begin(), latencias.end());
+    r.p50 = percentil(latencias, 0.50);
+    r.p90 = percentil(latencias, 0.90);
+    r.p99 = percentil(latencias, 0.99);
+    r.maximo = latencias.empty() ? 0 : latencias.back();
+    double suma = 0;
+    for (double l : latencias) suma += l;
+    r.promedio = latencias.empty() ? 0 : suma / latencias.size();
+
+    r.io.bytesLeidos = despues.bytesLeidos - antes.bytesLeidos;
+    r.io.bytesEscritos = despues.bytesEscritos - antes.bytesEscritos;
+    r.io.llamadasLectura = despues.llamadasLectura - antes.llamadasLectura;
+    r.io.llamadasEscritura = despues.llamadasEscritura - antes.llamadasEscritura;
+    r.registrosLeidos = registrosAntes >= 0 ? registrosDespues - registrosAntes : -1;
+    return r;
+}
+
+// ============================================================================
+// SALIDA
+// ============================================================================
+
+void imprimirResultado(const ResultadoOperacion& r) {
+    double porOp = r.iteraciones > 0 ? r.iteraciones : 1;
+    double throughput = r.segundosTotales > 0 ? r.iteraciones / r.segundosTotales : 0;
+    cout << left << setw(28) << r.operacion << right
+         << setw(10) << r.registros
+         << setw(6) << r.iteraciones
+         << fixed << setprecision(1)
+         << setw(12) << r.p50
+         << setw(12) << r.p90
+         << setw(12) << r.p99
+         << setw(12) << r.maximo
+         << setw(12) << throughput
+         << setw(14) << (long long)(r.io.bytesLeidos / porOp)
+         << setw(10) << (long long)((r.io.llamadasLectura + r.io.llamadasEscritura) / porOp)
+         << setw(10) << (r.registrosLeidos >= 0 ? (long long)(r.registrosLeidos / porOp) : -1)
+         << endl;
+}
+
+bool escribirJSON(const char* nombreArchivo, unsigned semilla, const vector<ResultadoOperacion>& resultados) {
+    ofstream archivo(nombreArchivo);
+    if (!archivo.is_open()) {
+        return false;
+    }
+
+    archivo << "{\n  \"version\": 1,\n  \"semilla\": " << semilla
+            << ",\n  \"fecha\": " << (long long)time(0)
+            << ",\n  \"resultados\": [\n";
+    for (size_t i = 0; i < resultados.size(); i++) {
+        const ResultadoOperacion& r = resultados[i];
+        archivo << fixed << setprecision(3)
+                << "    {\"operacion\": \"" << r.operacion << "\""
+                << ", \"registros\": " << r.registros
+                << ", \"iteraciones\": " << r.iteraciones
+                << ", \"segundos\": " << r.segundosTotales
+                << ", \"p50_us\": " << r.p50
+                << ", \"p90_us\": " << r.p90
+                << ", \"p99_us\": " << r.p99
+                << ", \"max_us\": " << r.maximo
+                << ", \"promedio_us\": " << r.promedio
+                << ", \"ops_por_segundo\": " << (r.segundosTotales > 0 ? r.iteraciones / r.segundosTotales : 0)
+                << ", \"bytes_leidos\": " << r.io.bytesLeidos
+                << ", \"bytes_escritos\": " << r.io.bytesEscritos
+                << ", \"syscalls_lectura\": " << r.io.llamadasLectura
+                << ", \"syscalls_escritura\": " << r.io.llamadasEscritura
+                << ", \"registros_leidos\": " << r.registrosLeidos
+                << "}" << (i + 1 < resultados.size() ? "," : "") << "\n";
+    }
+    archivo << "  ]\n}\n";
+    return true;
+}
+
+// ============================================================================
+// PROGRAMA PRINCIPAL
+// ============================================================================
+
+vector<int> parsearLista(const string& texto) {
+    vector<int> valores;
+    stringstream ss(texto);
+    string item;
+    while (getline(ss, item, ',')) {
+        if (!item.empty()) valores.push_back(atoi(item.c_str()));
+    }
+    return valores;
+}
+
+int main(int argc, char* argv[]) {
+    vector<int> tamanos = {1000, 10000};
+    int iteraciones = 20;
+    double tiempoMaximo = 10.0;
+    unsigned semilla = 42;
+    string filtro = "";
+    string directorio = "bench_datos";
+    string salida = "resultados_benchmark.json";
+    vector<int> cacheKB = {(int)(PRESUPUESTO_CACHE_PACIENTES / 1024), (int)(PRESUPUESTO_CACHE_DOCTORES / 1024)};
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string opcion = argv[i];
+        string valor = argv[i + 1];
+        if (opcion == "--tamanos") tamanos = parsearLista(valor);
+        else if (opcion == "--iteraciones") iteraciones = atoi(valor.c_str());
+        else if (opcion == "--tiempo-max") tiempoMaximo = atof(valor.c_str());
+        else if (opcion == "--semilla") semilla = (unsigned)atoi(valor.c_str());
+        else if (opcion == "--operaciones") filtro = "," + valor + ",";
+        else if (opcion == "--directorio") directorio = valor;
+        else if (opcion == "--salida") salida = valor;
+        else if (opcion == "--cache-kb") cacheKB = parsearLista(valor);
+        else {
+            cout << "Opcion desconocida: " << opcion << endl;
+            return 1;
+        }
+    }
+
+    while (cacheKB.size() < 2) cacheKB.push_back(0);
+    configurarCachesRegistros((size_t)cacheKB[0] * 1024, (size_t)cacheKB[1] * 1024);
+
+    filesystem::path directorioInicial = filesystem::current_path();
+    filesystem::path rutaSalida = filesystem::absolute(salida);
+    vector<ResultadoOperacion> resultados;
+
+    cout << left << setw(28) << "OPERACION" << right
+         << setw(10) << "REGISTROS" << setw(6) << "ITER"
+         << setw(12) << "P50(us)" << setw(12) << "P90(us)" << setw(12) << "P99(us)"
+         << setw(12) << "MAX(us)" << setw(12) << "OPS/S"
+         << setw(14) << "BYTES/OP" << setw(10) << "SYSC/OP" << setw(10) << "REG/OP" << endl;
+
+    for (int n : tamanos) {
+        filesystem::path dir = directorioInicial / directorio / to_string(n);
+        filesystem::create_directories(dir);
+        filesystem::current_path(dir);
+
+        ConfigGenerador config = configGeneradorPorDefecto();
+        config.pacientes = n;
+        config.doctores = max(10, n / 100);
+        config.citas = n;
+        config.consultas = n;
+        config.semilla = semilla;
+        Fecha diaInicial = diasDesdeCivil(config.anioInicio, 1, 1);
+        int diasTotales = config.anios * 365;
+        if (!generarDatos(config)) {
+            mostrarError("No se pudo generar el conjunto de datos");
+            return 1;
+        }
+
+        BufferNulo nulo;
+        streambuf* salidaOriginal = cout.rdbuf(&nulo);
+        cargarDatosHospital();
+        cout.rdbuf(salidaOriginal);
+
+        mt19937 rng(semilla + n);
+        auto pacienteAleatorio = [&]() { return 1 + (int)(rng() % config.pacientes); };
+        auto doctorAleatorio = [&]() { return 1 + (int)(rng() % config.doctores); };
+
+        // Las operaciones de solo lectura van primero; las que modifican
+        // los archivos despues, y el mantenimiento al final.
+        vector<pair<string, function<void(int)>>> operaciones;
+        int pesadas = min(iteraciones, 3);
+
+        operaciones.push_back({"buscarPacientePorID", [&](int) {
+            buscarPacientePorID(pacienteAleatorio());
+        }});
+        operaciones.push_back({"buscarDoctorPorID", [&](int) {
+            buscarDoctorPorID(doctorAleatorio());
+        }});
+        operaciones.push_back({"buscarPacientePorCedula", [&](int) {
+            char cedula[20];
+            snprintf(cedula, 20, "V-%08d", pacienteAleatorio());
+            buscarPacientePorCedula(cedula);
+        }});
+        operaciones.push_back({"buscarPacientesPorApellido", [&](int) {
+            string prefijo = string(APELLIDOS_GEN[rng() % cantidadGen(APELLIDOS_GEN)]).substr(0, 3);
+            buscarPacientesPorApellido(prefijo.c_str(), "", 50);
+        }});
+        operaciones.push_back({"buscarRegistrosConTexto", [&](int) {
+            buscarRegistrosConTexto<Cita>(ARCHIVO_CITAS, CAMPO_TEXTO(Cita, motivo), "laboratorio", true, -1);
+        }});
+        operaciones.push_back({"verificarDisponibilidad", [&](int) {
+            Fecha fecha = diaInicial + (int)(rng() % diasTotales);
+            Hora hora = (Hora)((8 + (int)(rng() % 8)) * 60 + (int)(rng() % 2) * 30);
+            verificarDisponibilidad(doctorAleatorio(), fecha, hora);
+        }});
+        operaciones.push_back({"buscarCitasPorFecha", [&](int) {
+            Fecha desde = diaInicial + (int)(rng() % diasTotales);
+            buscarCitasPorFecha(desde, desde + 6, doctorAleatorio(), -1);
+        }});
+        operaciones.push_back({"buscarTurnosLibres", [&](int) {
+            Fecha desde = diaInicial + (int)(rng() % diasTotales);
+            buscarTurnosLibres(doctorAleatorio(), nullptr, desde, 0, 10);
+        }});
+        operaciones.push_back({"doctorMenosCargado", [&](int) {
+            // Misma ventana en todas las iteraciones: la primera arma los monticulos
+            Fecha desde = diaInicial + diasTotales / 2;
+            doctorMenosCargado(ESPECIALIDADES_GEN[rng() % cantidadGen(ESPECIALIDADES_GEN)], desde);
+        }});
+        operaciones.push_back({"mostrarAgendaDoctor", [&](int) {
+            Fecha desde = diaInicial + (int)(rng() % diasTotales);
+            mostrarAgendaDoctor(doctorAleatorio(), desde, desde + 6);
+        }});
+        operaciones.push_back({"listarCitasPaciente", [&](int) {
+            listarCitasPaciente(pacienteAleatorio());
+        }});
+        operaciones.push_back({"mostrarHistorialMedico", [&](int) {
+            mostrarHistorialMedico(pacienteAleatorio());
+        }});
+        operaciones.push_back({"listarPacientes", [&](int) {
+            listarPacientes();
+        }});
+        operaciones.push_back({"mostrarTableroDiario", [&](int) {
+            Fecha hasta = diaInicial + (int)(rng() % diasTotales);
+            mostrarTableroDiario(hasta - 29, hasta);
+        }});
+        operaciones.push_back({"calcularReporteAnalitico", [&](int) {
+            ReporteAnalitico reporte;
+            calcularReporteAnalitico(reporte);
+        }});
+        operaciones.push_back({"agregarCita", [&](int) {
+            Cita c;
+            memset(&c, 0, sizeof(Cita));
+            c.pacienteID = pacienteAleatorio();
+            c.doctorID = doctorAleatorio();
+            c.fecha = diaInicial + (int)(rng() % diasTotales);
+            c.hora = parsearHora("07:00");
+            strcpy(c.motivo, "Benchmark");
+            c.estado = CITA_AGENDADA;
+            agregarCita(c);
+        }});
+        operaciones.push_back({"agregarConsultaAlHistorial", [&](int) {
+            HistorialMedico h;
+            memset(&h, 0, sizeof(HistorialMedico));
+            h.pacienteID = pacienteAleatorio();
+            h.doctorID = doctorAleatorio();
+            h.fecha = diaInicial + (int)(rng() % diasTotales);
+            h.hora = parsearHora("07:00");
+            strcpy(h.diagnostico, "Benchmark");
+            h.costo = 10.0f;
+            agregarConsultaAlHistorial(h);
+        }});
+
+        for (auto& op : operaciones) {
+            if (!filtro.empty() && filtro.find("," + op.first + ",") == string::npos) continue;
+            resultados.push_back(medirOperacion(op.first, n, iteraciones, tiempoMaximo, op.second));
+            imprimirResultado(resultados.back());
+        }
+
+        vector<pair<string, function<void(int)>>> mantenimiento;
+        mantenimiento.push_back({"compactarArchivoPacientes", [&](int) { compactarArchivoPacientes(); }});
+        mantenimiento.push_back({"crearRespaldo", [&](int) { crearRespaldo(); }});
+        mantenimiento.push_back({"restaurarRespaldo", [&](int) { restaurarRespaldo(); }});
+
+        for (auto& op : mantenimiento) {
+            if (!filtro.empty() && filtro.find("," + op.first + ",") == string::npos) continue;
+            resultados.push_back(medirOperacion(op.first, n, pesadas, tiempoMaximo, op.second));
+            imprimirResultado(resultados.back());
+        }
+
+        filesystem::current_path(directorioInicial);
+    }
+
+    if (!escribirJSON(rutaSalida.string().c_str(), semilla, resultados)) {
+        mostrarError("No se pudo escribir el archivo de resultados");
+        return 1;
+    }
+    cout << "* Resultados guardados en " << rutaSalida.string() << endl;
+    return 0;
+}
@@ -0,0 +1,542 @@
+// ============================================================================
+// PRUEBA DE CARGA: MOSTRADORES DE RECEPCION CONCURRENTES
+// ============================================================================
+// Compilar:  g++ -std=c++17 -O2 -pthread -o carga herramientas/carga.cpp
+// Uso:       carga [--directorio DIR] [--generar N] [--clientes 8]
+//                  [--tasa 200] [--duracion 30] [--mezcla 70,20,8,2]
+//                  [--semilla 42] [--traza archivo.txt] [--grabar archivo.txt]
+//                  [--velocidad 1.0] [--salida carga.json]
+//                  [--metricas metricas.json] [--chrome traza.json]
+//                  [--cache-kb 8192,1024]
+//
+// Reproduce una traza (grabada o sintetica) contra las funciones de
+// almacenamiento de funciones.H desde N clientes concurrentes. Con --tasa > 0
+// las operaciones llegan en tiempos programados (lazo abierto) y la latencia
+// se mide desde el instante programado, de modo que la cola acumulada por
+// saturacion aparece en los percentiles. Con --tasa 0 cada cliente ejecuta
+// operaciones una tras otra (lazo cerrado, throughput maximo).
+//
+// Formato de traza (una operacion por linea, '#' para comentarios):
+//   <ms> buscarPacientePorID <id>
+//   <ms> buscarPacientePorCedula <cedula>
+//   <ms> agendarCita <pacienteID> <doctorID> <YYYY-MM-DD> <HH:MM>
+//   <ms> registrarConsulta <pacienteID> <doctorID> <YYYY-MM-DD> <HH:MM> <costo>
+//   <ms> cancelarCita <citaID>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <mutex>
+#include <shared_mutex>
+#include <filesystem>
+#include "../funciones.H"
+#include "generador.h"
+
+using namespace std;
+
+// ============================================================================
+// TRAZA
+// ============================================================================
+
+enum TipoOperacion { OP_BUSCAR_ID, OP_BUSCAR_CEDULA, OP_AGENDAR, OP_CONSULTA, OP_CANCELAR, CANT_TIPOS_OP };
+
+const char* NOMBRES_OPERACION[] = {
+    "buscarPacientePorID", "buscarPacientePorCedula", "agendarCita",
+    "registrarConsulta", "cancelarCita"
+};
+
+struct OperacionTraza {
+    double milisegundo;         // Instante programado desde el inicio
+    TipoOperacion tipo;
+    int id1;                    // pacienteID o citaID
+    int id2;                    // doctorID
+    char cedula[20];
+    Fecha fecha;
+    Hora hora;
+    float costo;
+};
+
+bool leerTraza(const char* nombreArchivo, vector<OperacionTraza>& traza) {
+    ifstream archivo(nombreArchivo);
+    if (!archivo.is_open()) {
+        return false;
+    }
+
+    string linea;
+    while (getline(archivo, linea)) {
+        if (linea.empty() || linea[0] == '#') continue;
+        stringstream ss(linea);
+        string nombre;
+        OperacionTraza op;
+        memset(&op, 0, sizeof(OperacionTraza));
+        ss >> op.milisegundo >> nombre;
+
+        if (nombre == "buscarPacientePorID") {
+            op.tipo = OP_BUSCAR_ID;
+            ss >> op.id1;
+        } else if (nombre == "buscarPacientePorCedula") {
+            op.tipo = OP_BUSCAR_CEDULA;
+            string cedula;
+            ss >> cedula;
+            strncpy(op.cedula, cedula.c_str(), 19);
+        } else if (nombre == "agendarCita" || nombre == "registrarConsulta") {
+            op.tipo = nombre == "agendarCita" ? OP_AGENDAR : OP_CONSULTA;
+            string fecha, hora;
+            ss >> op.id1 >> op.id2 >> fecha >> hora >> op.costo;
+            op.fecha = parsearFecha(fecha.c_str());
+            op.hora = parsearHora(hora.c_str());
+        } else if (nombre == "cancelarCita") {
+            op.tipo = OP_CANCELAR;
+            ss >> op.id1;
+        } else {
+            cout << "* Operacion desconocida en traza: " << nombre << endl;
+            continue;
+        }
+        traza.push_back(op);
+    }
+    return true;
+}
+
+bool grabarTraza(const char* nombreArchivo, const vector<OperacionTraza>& traza) {
+    ofstream archivo(nombreArchivo);
+    if (!archivo.is_open()) {
+        return false;
+    }
+
+    archivo << "# ms operacion parametros" << endl;
+    for (const OperacionTraza& op : traza) {
+        archivo << fixed << setprecision(3) << op.milisegundo << " " << NOMBRES_OPERACION[op.tipo];
+        switch (op.tipo) {
+            case OP_BUSCAR_ID:
+            case OP_CANCELAR:
+                archivo << " " << op.id1;
+                break;
+            case OP_BUSCAR_CEDULA:
+                archivo << " " << op.cedula;
+                break;
+            default:
+                archivo << " " << op.id1 << " " << op.id2 << " " << textoFecha(op.fecha) << " " << textoHora(op.hora)
+                        << " " << setprecision(2) << op.costo;
+        }
+        archivo << "\n";
+    }
+    return true;
+}
+
+// FUNCION: Traza sintetica con llegadas de Poisson y la mezcla indicada
+vector<OperacionTraza> generarTraza(int cantidad, double tasa, const vector<int>& mezcla, unsigned semilla) {
+    ArchivoHeader hPacientes = leerHeader(ARCHIVO_PACIENTES);
+    ArchivoHeader hDoctores = leerHeader(ARCHIVO_DOCTORES);
+    ArchivoHeader hCitas = leerHeader(ARCHIVO_CITAS);
+    int maxPaciente = max(1, hPacientes.proximoID - 1);
+    int maxDoctor = max(1, hDoctores.proximoID - 1);
+    int maxCita = max(1, hCitas.proximoID - 1);
+
+    // cancelarCita solo acepta citas agendadas: los destinos salen de las
+    // agendadas al iniciar, sin repetir, para medir cancelaciones reales y no
+    // el camino de error. Si se acaban se elige cualquier ID.
+    vector<int> agendadas = proyectarRegistros<Cita>(ARCHIVO_CITAS,
+        [](const Cita& c) { return c.estado == CITA_AGENDADA; },
+        [](const Cita& c) { return c.id; });
+
+    mt19937_64 rng(semilla);
+    exponential_distribution<double> llegada(tasa > 0 ? tasa / 1000.0 : 1.0);
+    int sumaMezcla = mezcla[0] + mezcla[1] + mezcla[2] + mezcla[3];
+    Fecha diaHoy = fechaHoy();
+
+    vector<OperacionTraza> traza;
+    double reloj = 0;
+    for (int i = 0; i < cantidad; i++) {
+        OperacionTraza op;
+        memset(&op, 0, sizeof(OperacionTraza));
+        if (tasa > 0) reloj += llegada(rng);
+        op.milisegundo = tasa > 0 ? reloj : 0;
+
+        int dado = (int)(rng() % max(1, sumaMezcla));
+        op.id1 = 1 + (int)(rng() % maxPaciente);
+        op.id2 = 1 + (int)(rng() % maxDoctor);
+        op.fecha = diaHabilGen(diaHoy + (int)(rng() % 60));
+        op.hora = horaGenerada(rng);
+        op.costo = 20.0f + (float)(rng() % 16) * 5;
+
+        if (dado < mezcla[0]) {
+            op.tipo = (rng() % 2) ? OP_BUSCAR_ID : OP_BUSCAR_CEDULA;
+            snprintf(op.cedula, 20, "V-%08d", op.id1);
+        } else if (dado < mezcla[0] + mezcla[1]) {
+            op.tipo = OP_AGENDAR;
+        } else if (dado < mezcla[0] + mezcla[1] + mezcla[2]) {
+            op.tipo = OP_CONSULTA;
+        } else {
+            op.tipo = OP_CANCELAR;
+            if (agendadas.empty()) {
+                op.id1 = 1 + (int)(rng() % maxCita);
+            } else {
+                size_t elegida = (size_t)(rng() % agendadas.size());
+                op.id1 = agendadas[elegida];
+                agendadas[elegida] = agendadas.back();
+                agendadas.pop_back();
+            }
+        }
+        traza.push_back(op);
+    }
+    return traza;
+}
+
+// ============================================================================
+// HISTOGRAMAS
+// ============================================================================
+
+// Latencias en microsegundos sobre el histograma log-lineal de metricas.h
+struct Histograma {
+    HistogramaLatencia latencias;
+    long long errores;
+};
+
+void limpiarHistograma(Histograma& h) {
+    limpiarHistograma(h.latencias);
+    h.errores = 0;
+}
+
+void registrarLatencia(Histograma& h, double microsegundos, bool error) {
+    registrarEnHistograma(h.latencias, (long long)microsegundos);
+    if (error) h.errores++;
+}
+
+void combinarHistograma(Histograma& destino, const Histograma& origen) {
+    combinarHistogramas(destino.latencias, origen.latencias);
+    destino.errores += origen.errores;
+}
+
+double percentilHistograma(const Histograma& h, double p) {
+    return (double)percentilHistograma(h.latencias, p);
+}
+
+// ============================================================================
+// EJECUCION
+// ============================================================================
+
+// Las funciones de funciones.H no son seguras entre hilos: las lecturas se
+// ejecutan en paralelo y las escrituras en exclusiva, como lo haria un
+// servidor con un candado de lectores/escritor delante del almacenamiento.
+shared_mutex candadoAlmacenamiento;
+
+struct BufferNulo : streambuf {
+    int overflow(int c) { return c; }
+};
+
+// FUNCION: Ejecutar una operacion de la traza; devuelve false si fallo
+bool ejecutarOperacion(const OperacionTraza& op) {
+    TRAZA_ACCION(NOMBRES_OPERACION[op.tipo]);
+    switch (op.tipo) {
+        case OP_BUSCAR_ID: {
+            shared_lock<shared_mutex> lectura(candadoAlmacenamiento);
+            return buscarPacientePorID(op.id1).id != -1;
+        }
+        case OP_BUSCAR_CEDULA: {
+            shared_lock<shared_mutex> lectura(candadoAlmacenamiento);
+            return buscarPacientePorCedula(op.cedula).id != -1;
+        }
+        case OP_AGENDAR: {
+            unique_lock<shared_mutex> escritura(candadoAlmacenamiento);
+            if (!verificarDisponibilidad(op.id2, op.fecha, op.hora)) {
+                return false;
+            }
+            Cita cita;
+            memset(&cita, 0, sizeof(Cita));
+            cita.pacienteID = op.id1;
+            cita.doctorID = op.id2;
+            cita.fecha = op.fecha;
+            cita.hora = op.hora;
+            strcpy(cita.motivo, "Prueba de carga");
+            cita.estado = CITA_AGENDADA;
+            return agregarCita(cita);
+        }
+        case OP_CONSULTA: {
+            unique_lock<shared_mutex> escritura(candadoAlmacenamiento);
+            HistorialMedico consulta;
+            memset(&consulta, 0, sizeof(HistorialMedico));
+            consulta.pacienteID = op.id1;
+            consulta.doctorID = op.id2;
+            consulta.fecha = op.fecha;
+            consulta.hora = op.hora;
+            strcpy(consulta.diagnostico, "Prueba de carga");
+            consulta.costo = op.costo;
+            return agregarConsultaAlHistorial(consulta);
+        }
+        case OP_CANCELAR: {
+            unique_lock<shared_mutex> escritura(candadoAlmacenamiento);
+            return cancelarCita(op.id1);
+        }
+        default:
+            return false;
+    }
+}
+
+struct EstadisticasCliente {
+    Histograma porTipo[CANT_TIPOS_OP];
+    vector<Histograma> porSegundo;
+};
+
+int main(int argc, char* argv[]) {
+    string directorio = ".";
+    int generar = 0;
+    int clientes = 8;
+    double tasa = 200;
+    double duracion = 30;
+    vector<int> mezcla = {70, 20, 8, 2};
+    unsigned semilla = 42;
+    string archivoTraza = "";
+    string archivoGrabar = "";
+    double velocidad = 1.0;
+    string salida = "resultados_carga.json";
+    string archivoMetricas = "";
+    string archivoChrome = "";
+    size_t cachePacientesKB = PRESUPUESTO_CACHE_PACIENTES / 1024;
+    size_t cacheDoctoresKB = PRESUPUESTO_CACHE_DOCTORES / 1024;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string opcion = argv[i];
+        string valor = argv[i + 1];
+        if (opcion == "--directorio") directorio = valor;
+        else if (opcion == "--generar") generar = atoi(valor.c_str());
+        else if (opcion == "--clientes") clientes = max(1, atoi(valor.c_str()));
+        else if (opcion == "--tasa") tasa = atof(valor.c_str());
+        else if (opcion == "--duracion") duracion = atof(valor.c_str());
+        else if (opcion == "--semilla") semilla = (unsigned)atol(valor.c_str());
+        else if (opcion == "--traza") archivoTraza = valor;
+        else if (opcion == "--grabar") archivoGrabar = valor;
+        else if (opcion == "--velocidad") velocidad = atof(valor.c_str());
+        else if (opcion == "--salida") salida = valor;
+        else if (opcion == "--metricas") archivoMetricas = valor;
+        else if (opcion == "--chrome") archivoChrome = valor;
+        else if (opcion == "--cache-kb") {
+            // "pacientes,doctores"; 0,0 deshabilita las caches
+            cachePacientesKB = (size_t)atol(valor.c_str());
+            size_t coma = valor.find(',');
+            cacheDoctoresKB = coma == string::npos ? cacheDoctoresKB : (size_t)atol(valor.c_str() + coma + 1);
+        }
+        else if (opcion == "--mezcla") {
+            stringstream ss(valor);
+            string parte;
+            mezcla.clear();
+            while (getline(ss, parte, ',')) mezcla.push_back(atoi(parte.c_str()));
+            while (mezcla.size() < 4) mezcla.push_back(0);
+        } else {
+            cout << "* Error: Opcion desconocida " << opcion << endl;
+            return 1;
+        }
+    }
+
+    filesystem::path rutaSalida = filesystem::absolute(salida);
+    filesystem::path rutaTraza = archivoTraza.empty() ? "" : filesystem::absolute(archivoTraza);
+    filesystem::path rutaGrabar = archivoGrabar.empty() ? "" : filesystem::absolute(archivoGrabar);
+    filesystem::path rutaMetricas = archivoMetricas.empty() ? "" : filesystem::absolute(archivoMetricas);
+    filesystem::path rutaChrome = archivoChrome.empty() ? "" : filesystem::absolute(archivoChrome);
+    filesystem::create_directories(directorio);
+    filesystem::current_path(directorio);
+
+    if (generar > 0) {
+        ConfigGenerador config = configGeneradorPorDefecto();
+        config.pacientes = generar;
+        config.doctores = max(10, generar / 500);
+        config.citas = generar * 2;
+        config.consultas = generar * 2;
+        config.semilla = semilla;
+        cout << "** Generando datos (" << generar << " pacientes)..." << endl;
+        if (!generarDatos(config)) {
+            mostrarError("No se pudo generar el conjunto de datos");
+            return 1;
+        }
+    }
+
+    configurarCachesRegistros(cachePacientesKB * 1024, cacheDoctoresKB * 1024);
+    BufferNulo nulo;
+    streambuf* salidaOriginal = cout.rdbuf(&nulo);
+    bool cargado = cargarDatosHospital();
+    cout.rdbuf(salidaOriginal);
+    if (!cargado) {
+        mostrarError("No se pudieron cargar los archivos del sistema");
+        return 1;
+    }
+
+    vector<OperacionTraza> traza;
+    if (!archivoTraza.empty()) {
+        if (!leerTraza(rutaTraza.string().c_str(), traza)) {
+            mostrarError("No se pudo leer la traza");
+            return 1;
+        }
+        for (OperacionTraza& op : traza) op.milisegundo /= velocidad;
+    } else {
+        int cantidad = tasa > 0 ? (int)(tasa * duracion) : (int)(1000 * duracion);
+        traza = generarTraza(cantidad, tasa, mezcla, semilla);
+    }
+    if (!archivoGrabar.empty() && !grabarTraza(rutaGrabar.string().c_str(), traza)) {
+        mostrarError("No se pudo grabar la traza");
+    }
+
+    cout << "** " << traza.size() << " operaciones, " << clientes << " clientes, "
+         << (tasa > 0 || !archivoTraza.empty() ? "lazo abierto" : "lazo cerrado") << endl;
+
+    bool lazoAbierto = tasa > 0 || !archivoTraza.empty();
+    vector<EstadisticasCliente> estadisticas(clientes);
+    for (EstadisticasCliente& e : estadisticas) {
+        for (int t = 0; t < CANT_TIPOS_OP; t++) limpiarHistograma(e.porTipo[t]);
+    }
+    atomic<size_t> siguiente(0);
+    atomic<int> clientesTerminados(0);
+    activarTraza(!archivoChrome.empty());
+
+    // Las funciones imprimen en cout; se silencia una sola vez para todos los hilos
+    salidaOriginal = cout.rdbuf(&nulo);
+    auto inicio = chrono::steady_clock::now();
+
+    auto cliente = [&](int numero) {
+        EstadisticasCliente& est = estadisticas[numero];
+        size_t i;
+        while ((i = siguiente.fetch_add(1)) < traza.size()) {
+            const OperacionTraza& op = traza[i];
+            auto programado = inicio + chrono::microseconds((long long)(op.milisegundo * 1000));
+            if (lazoAbierto) {
+                this_thread::sleep_until(programado);
+            } else {
+                programado = chrono::steady_clock::now();
+            }
+
+            bool ok = ejecutarOperacion(op);
+            auto fin = chrono::steady_clock::now();
+            double latencia = chrono::duration<double, micro>(fin - programado).count();
+            size_t segundo = (size_t)chrono::duration<double>(fin - inicio).count();
+
+            registrarLatencia(est.porTipo[op.tipo], latencia, !ok);
+            if (est.porSegundo.size() <= segundo) {
+                size_t anterior = est.porSegundo.size();
+                est.porSegundo.resize(segundo + 1);
+                for (size_t s = anterior; s <= segundo; s++) limpiarHistograma(est.porSegundo[s]);
+            }
+            registrarLatencia(est.porSegundo[segundo], latencia, !ok);
+        }
+        clientesTerminados++;
+    };
+
+    vector<thread> hilos;
+    for (int c = 0; c < clientes; c++) hilos.push_back(thread(cliente, c));
+
+    // Vaciar los buffers de traza mientras corre, para no perder eventos
+    while (!archivoChrome.empty() && clientesTerminados.load() < clientes) {
+        this_thread::sleep_for(chrono::milliseconds(100));
+        vaciarTraza();
+    }
+    for (thread& t : hilos) t.join();
+
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    cout.rdbuf(salidaOriginal);
+
+    // Combinar los histogramas de todos los clientes
+    Histograma total;
+    limpiarHistograma(total);
+    Histograma porTipo[CANT_TIPOS_OP];
+    vector<Histograma> porSegundo;
+    for (int t = 0; t < CANT_TIPOS_OP; t++) limpiarHistograma(porTipo[t]);
+    for (EstadisticasCliente& e : estadisticas) {
+        for (int t = 0; t < CANT_TIPOS_OP; t++) {
+            combinarHistograma(porTipo[t], e.porTipo[t]);
+            combinarHistograma(total, e.porTipo[t]);
+        }
+        if (porSegundo.size() < e.porSegundo.size()) {
+            size_t anterior = porSegundo.size();
+            porSegundo.resize(e.porSegundo.size());
+            for (size_t s = anterior; s < porSegundo.size(); s++) limpiarHistograma(porSegundo[s]);
+        }
+        for (size_t s = 0; s < e.porSegundo.size(); s++) combinarHistograma(porSegundo[s], e.porSegundo[s]);
+    }
+
+    cout << "\n** LATENCIA EN EL TIEMPO (ms)" << endl;
+    cout << setw(6) << "SEG" << setw(10) << "OPS" << setw(8) << "ERR"
+         << setw(10) << "P50" << setw(10) << "P99" << setw(10) << "MAX" << endl;
+    for (size_t s = 0; s < porSegundo.size(); s++) {
+        const Histograma& h = porSegundo[s];
+        cout << fixed << setprecision(2) << setw(6) << s << setw(10) << h.latencias.total << setw(8) << h.errores
+             << setw(10) << percentilHistograma(h, 0.50) / 1000
+             << setw(10) << percentilHistograma(h, 0.99) / 1000
+             << setw(10) << h.latencias.maximo / 1000 << endl;
+    }
+
+    cout << "\n** RESUMEN POR OPERACION (ms)" << endl;
+    cout << left << setw(26) << "OPERACION" << right << setw(9) << "OPS" << setw(8) << "ERR"
+         << setw(10) << "P50" << setw(10) << "P90" << setw(10) << "P99" << setw(10) << "P99.9"
+         << setw(10) << "MAX" << endl;
+    for (int t = 0; t < CANT_TIPOS_OP; t++) {
+        const Histograma& h = porTipo[t];
+        cout << left << setw(26) << NOMBRES_OPERACION[t] << right << setw(9) << h.latencias.total << setw(8) << h.errores
+             << setw(10) << percentilHistograma(h, 0.50) / 1000
+             << setw(10) << percentilHistograma(h, 0.90) / 1000
+             << setw(10) << percentilHistograma(h, 0.99) / 1000
+             << setw(10) << percentilHistograma(h, 0.999) / 1000
+             << setw(10) << h.latencias.maximo / 1000 << endl;
+    }
+
+    double logrado = segundos > 0 ? total.latencias.total / segundos : 0;
+    double objetivo = lazoAbierto && !traza.empty() && traza.back().milisegundo > 0 ?
+        traza.size() / (traza.back().milisegundo / 1000.0) : 0;
+    cout << "\n* Throughput logrado: " << logrado << " ops/s";
+    if (objetivo > 0) {
+        cout << " (objetivo " << objetivo << " ops/s"
+             << (logrado < objetivo * 0.95 ? ", SATURADO" : "") << ")";
+    }
+    cout << endl << "* Errores: " << total.errores << " de " << total.latencias.total << endl;
+    for (const ResumenCache& c : leerCaches()) {
+        cout << "* Cache de " << c.nombre << ": " << c.aciertos << " aciertos, " << c.fallos << " fallos ("
+             << setprecision(1) << tasaAciertosCache(c) << "%), " << c.entradas << " registros, "
+             << c.bytesUsados / 1024 << " de " << c.presupuesto / 1024 << " KB" << endl;
+    }
+
+    ofstream json(rutaSalida);
+    if (!json.is_open()) {
+        mostrarError("No se pudo escribir el archivo de resultados");
+        return 1;
+    }
+    json << fixed << setprecision(3)
+         << "{\n  \"version\": 1,\n  \"clientes\": " << clientes
+         << ",\n  \"operaciones\": " << total.latencias.total
+         << ",\n  \"errores\": " << total.errores
+         << ",\n  \"segundos\": " << segundos
+         << ",\n  \"ops_por_segundo\": " << logrado
+         << ",\n  \"ops_por_segundo_objetivo\": " << objetivo
+         << ",\n  \"por_operacion\": [\n";
+    for (int t = 0; t < CANT_TIPOS_OP; t++) {
+        const Histograma& h = porTipo[t];
+        json << "    {\"operacion\": \"" << NOMBRES_OPERACION[t] << "\", \"ops\": " << h.latencias.total
+             << ", \"errores\": " << h.errores
+             << ", \"p50_us\": " << percentilHistograma(h, 0.50)
+             << ", \"p90_us\": " << percentilHistograma(h, 0.90)
+             << ", \"p99_us\": " << percentilHistograma(h, 0.99)
+             << ", \"p999_us\": " << percentilHistograma(h, 0.999)
+             << ", \"max_us\": " << h.latencias.maximo << "}" << (t + 1 < CANT_TIPOS_OP ? "," : "") << "\n";
+    }
+    json << "  ],\n  \"por_segundo\": [\n";
+    for (size_t s = 0; s < porSegundo.size(); s++) {
+        const Histograma& h = porSegundo[s];
+        json << "    {\"segundo\": " << s << ", \"ops\": " << h.latencias.total << ", \"errores\": " << h.errores
+             << ", \"p50_us\": " << percentilHistograma(h, 0.50)
+             << ", \"p99_us\": " << percentilHistograma(h, 0.99)
+             << ", \"max_us\": " << h.latencias.maximo << "}" << (s + 1 < porSegundo.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+
+    cout << "* Resultados guardados en " << rutaSalida.string() << endl;
+
+    // Desglose interno de las funciones de almacenamiento (metricas.h)
+    if (!archivoMetricas.empty() && exportarMetricasJSON(rutaMetricas.string().c_str())) {
+        cout << "* Metricas de almacenamiento guardadas en " << rutaMetricas.string() << endl;
+    }
+    if (!archivoChrome.empty() && exportarTrazaChrome(rutaChrome.string().c_str())) {
+        cout << "* Traza de spans guardada en " << rutaChrome.string() << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+// ============================================================================
+// CONSULTAS AD-HOC EN LOTE
+// ============================================================================
+// Compilar:  g++ -std=c++17 -O2 -pthread -o consulta herramientas/consulta.cpp
+// Uso:       consulta [--directorio DIR] [--archivo consultas.txt]
+//                    [--pagina 0] ["consulta" ...]
+//
+// Ejecuta consultas del lenguaje de consulta.h sobre los archivos de DIR y
+// muestra el resultado de cada una con su tiempo. Las consultas salen de los
+// argumentos, de --archivo o, si no hay ninguna, de la entrada estandar (una
+// por linea, '#' para comentarios). Ejemplos:
+//
+//   consulta "pacientes donde edad > 65 y tipoSangre = O- y ultimaConsulta < hoy-365"
+//   consulta "citas donde estado = Agendada y doctorID = 7 y fecha entre 2026-10-01 y 2026-10-31"
+//   consulta "consultas donde diagnostico ~ gripe contar"
+//
+// Sale con 1 si alguna consulta no se entiende o no se pudo leer.
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <filesystem>
+#include "../funciones.H"
+
+using namespace std;
+
+// Descarta lo que cargarDatosHospital escribe en la consola
+struct BufferNulo : streambuf {
+    int overflow(int c) { return c; }
+};
+
+// FUNCION: Leer consultas de un flujo (una por linea; vacias y '#' se saltan)
+void leerConsultas(istream& entrada, vector<string>& consultas) {
+    string linea;
+    while (getline(entrada, linea)) {
+        size_t inicio = linea.find_first_not_of(" \t\r");
+        if (inicio == string::npos || linea[inicio] == '#') continue;
+        size_t fin = linea.find_last_not_of(" \t\r");
+        consultas.push_back(linea.substr(inicio, fin - inicio + 1));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    string directorio = ".";
+    string archivoConsultas = "";
+    int tamanoPagina = 0;
+    vector<string> consultas;
+
+    for (int i = 1; i < argc; i++) {
+        string opcion = argv[i];
+        if (opcion.rfind("--", 0) != 0) {
+            consultas.push_back(opcion);
+            continue;
+        }
+        if (i + 1 >= argc) {
+            cout << "* Error: Falta el valor de " << opcion << endl;
+            return 1;
+        }
+        string valor = argv[++i];
+        if (opcion == "--directorio") directorio = valor;
+        else if (opcion == "--archivo") archivoConsultas = valor;
+        else if (opcion == "--pagina") tamanoPagina = max(0, atoi(valor.c_str()));
+        else {
+            cout << "* Error: Opcion desconocida " << opcion << endl;
+            return 1;
+        }
+    }
+
+    if (!archivoConsultas.empty()) {
+        ifstream archivo(archivoConsultas);
+        if (!archivo.is_open()) {
+            mostrarError("No se pudo abrir el archivo de consultas");
+            return 1;
+        }
+        leerConsultas(archivo, consultas);
+    }
+    if (consultas.empty()) {
+        leerConsultas(cin, consultas);
+    }
+
+    filesystem::current_path(directorio);
+    BufferNulo nulo;
+    streambuf* salidaOriginal = cout.rdbuf(&nulo);
+    bool cargado = cargarDatosHospital();
+    cout.rdbuf(salidaOriginal);
+    if (!cargado) {
+        mostrarError("No se pudieron cargar los archivos del sistema");
+        return 1;
+    }
+
+    int fallidas = 0;
+    for (const string& texto : consultas) {
+        cout << "\n> " << texto << endl;
+        auto inicio = chrono::steady_clock::now();
+        bool correcta = ejecutarConsultaAdHoc(texto.c_str(), tamanoPagina);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+        cout << "(" << fixed << setprecision(2) << ms << " ms)" << endl;
+        if (!correcta) fallidas++;
+    }
+    return fallidas > 0 ? 1 : 0;
+}
@@ -0,0 +1,62 @@
+// ============================================================================
+// GENERADOR DE ARCHIVOS .bin A ESCALA
+// ============================================================================
+// Compilar:  g++ -std=c++17 -O2 -pthread -o generador herramientas/generador.cpp
+// Uso:       generador [--pacientes N] [--doctores N] [--citas N]
+//                      [--consultas N] [--semilla S] [--hilos H]
+//                      [--anio-inicio AAAA] [--anios A]
+//                      [--zipf-pacientes s] [--zipf-doctores s]
+//                      [--directorio DIR]
+//
+// La misma semilla produce archivos identicos byte a byte, con cualquier
+// cantidad de hilos.
+
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <filesystem>
+#include "generador.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    ConfigGenerador config = configGeneradorPorDefecto();
+    string directorio = ".";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string opcion = argv[i];
+        const char* valor = argv[i + 1];
+        if (opcion == "--pacientes") config.pacientes = atoi(valor);
+        else if (opcion == "--doctores") config.doctores = atoi(valor);
+        else if (opcion == "--citas") config.citas = atoi(valor);
+        else if (opcion == "--consultas") config.consultas = atoi(valor);
+        else if (opcion == "--semilla") config.semilla = (unsigned)atol(valor);
+        else if (opcion == "--hilos") config.hilos = atoi(valor);
+        else if (opcion == "--anio-inicio") config.anioInicio = atoi(valor);
+        else if (opcion == "--anios") config.anios = atoi(valor);
+        else if (opcion == "--zipf-pacientes") config.zipfPacientes = atof(valor);
+        else if (opcion == "--zipf-doctores") config.zipfDoctores = atof(valor);
+        else if (opcion == "--directorio") directorio = valor;
+        else {
+            cout << "* Error: Opcion desconocida " << opcion << endl;
+            return 1;
+        }
+    }
+
+    filesystem::create_directories(directorio);
+    filesystem::current_path(directorio);
+
+    cout << "** Generando " << config.pacientes << " pacientes, " << config.doctores
+         << " doctores, " << config.citas << " citas y " << config.consultas
+         << " consultas (semilla " << config.semilla << ")..." << endl;
+
+    auto inicio = chrono::steady_clock::now();
+    if (!generarDatos(config)) {
+        cout << "* Error: No se pudieron escribir los archivos" << endl;
+        return 1;
+    }
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+    cout << "* Archivos generados en " << fixed << setprecision(2) << segundos << " s" << endl;
+    return 0;
+}
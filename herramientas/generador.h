@@ -0,0 +1,529 @@
+#ifndef GENERADOR_H
+#define GENERADOR_H
+
+#include <fstream>
+#include <vector>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include "../estructuras.h.H"
+#include "../diccionario.h"
+#include "../funciones.H"
+
+using namespace std;
+
+// ============================================================================
+// GENERADOR DE DATOS SINTETICOS
+// ============================================================================
+// Escribe pacientes.bin, doctores.bin, citas.bin, historiales.bin,
+// hospital.bin y diccionarios.bin directamente en el formato ArchivoHeader + registros fijos,
+// sin pasar por los formularios interactivos. Los indices, mapas, columnas y
+// estadisticas que hubiera en el directorio se eliminan: describen los datos
+// anteriores y cargarDatosHospital los reconstruye.
+//
+// - Visitas por paciente y carga por doctor siguen distribuciones Zipf.
+// - Citas y consultas se reparten en orden cronologico sobre varios anios
+//   (el ID crece con la fecha, igual que al agregarlas desde el sistema).
+// - Los historiales quedan enlazados por primerConsultaID/siguienteConsultaID.
+// - Cada bloque de registros usa su propio generador sembrado con
+//   (semilla, archivo, bloque): el resultado es identico con cualquier
+//   cantidad de hilos (salvo la firma de cada header, que es nueva en cada
+//   corrida).
+
+struct ConfigGenerador {
+    int pacientes;
+    int doctores;
+    int citas;
+    int consultas;
+    unsigned semilla;
+    int hilos;                  // 0 = todos los nucleos
+    int anioInicio;             // Primer anio de citas/consultas
+    int anios;                  // Anios cubiertos por citas/consultas
+    double zipfPacientes;       // Exponente de visitas por paciente
+    double zipfDoctores;        // Exponente de carga por doctor
+};
+
+const int BLOQUE_GENERADOR = 8192;   // Registros por bloque (unidad de trabajo)
+
+// Etiquetas para separar las secuencias aleatorias de cada fase
+const int ETQ_DOCTORES = 1;
+const int ETQ_PACIENTES = 2;
+const int ETQ_CITAS_ASIGNACION = 3;
+const int ETQ_CITAS = 4;
+const int ETQ_CONSULTAS_ASIGNACION = 5;
+const int ETQ_CONSULTAS = 6;
+
+const char* NOMBRES_GEN[] = {
+    "Luis", "Maria", "Jose", "Ana", "Carlos", "Carmen", "Pedro", "Rosa",
+    "Jorge", "Elena", "Miguel", "Laura", "Rafael", "Sofia", "Andres", "Isabel",
+    "Juan", "Gabriela", "Diego", "Valentina", "Manuel", "Daniela", "Ricardo",
+    "Patricia", "Fernando", "Alejandra", "Oscar", "Veronica", "Victor", "Lucia"
+};
+const char* APELLIDOS_GEN[] = {
+    "Gonzalez", "Rodriguez", "Perez", "Hernandez", "Garcia", "Martinez",
+    "Lopez", "Diaz", "Romero", "Torres", "Ramirez", "Flores", "Rojas",
+    "Morales", "Castillo", "Mendoza", "Sanchez", "Vargas", "Medina", "Suarez",
+    "Rivas", "Guerrero", "Blanco", "Silva", "Marquez", "Pineda", "Salazar",
+    "Contreras", "Acosta", "Herrera"
+};
+const char* ESPECIALIDADES_GEN[] = {
+    "Medicina General", "Pediatria", "Cardiologia", "Ginecologia",
+    "Traumatologia", "Dermatologia", "Neurologia", "Oftalmologia"
+};
+const double PESOS_ESPECIALIDADES_GEN[] = {30, 18, 12, 12, 10, 7, 6, 5};
+
+const char* TIPOS_SANGRE_GEN[] = {
+    "O+", "A+", "B+", "O-", "A-", "AB+", "B-", "AB-"
+};
+const double PESOS_TIPOS_SANGRE_GEN[] = {39, 30, 9, 7, 6, 4, 2, 1};
+
+const char* HORARIOS_GEN[] = {
+    "Lun-Vie 08:00-16:00", "Lun-Vie 07:00-13:00", "Lun-Mie-Vie 08:00-12:00",
+    "Mar-Jue 13:00-19:00", "Lun-Sab 08:00-12:00"
+};
+const char* DIAGNOSTICOS_GEN[] = {
+    "Hipertension arterial", "Gripe comun", "Diabetes tipo 2", "Gastritis",
+    "Migrana", "Lumbalgia", "Dermatitis atopica", "Control rutinario",
+    "Asma bronquial", "Infeccion urinaria", "Faringitis", "Ansiedad"
+};
+const char* TRATAMIENTOS_GEN[] = {
+    "Reposo y control en 30 dias", "Dieta baja en sodio", "Hidratacion y reposo",
+    "Fisioterapia 10 sesiones", "Control de glicemia diario", "Sin tratamiento"
+};
+const char* MEDICAMENTOS_GEN[] = {
+    "Losartan 50mg", "Acetaminofen 500mg", "Metformina 850mg", "Omeprazol 20mg",
+    "Ibuprofeno 400mg", "Salbutamol inhalador", "Amoxicilina 500mg", "Ninguno"
+};
+const char* MOTIVOS_GEN[] = {
+    "Consulta de control", "Dolor de cabeza", "Fiebre", "Chequeo anual",
+    "Resultados de laboratorio", "Dolor abdominal", "Control de tension"
+};
+
+template<typename T, int N>
+int cantidadGen(T (&)[N]) { return N; }
+
+// ============================================================================
+// DISTRIBUCIONES Y FECHAS
+// ============================================================================
+
+// Muestreo Zipf por rechazo-inversion (memoria O(1), sirve para 10M rangos)
+struct DistribucionZipf {
+    int n;
+    double s;
+    double hIntegralX1;
+    double hIntegralN;
+    double umbral;
+};
+
+double zipfAuxiliar1(double x) { return fabs(x) > 1e-8 ? log1p(x) / x : 1 - x / 2; }
+double zipfAuxiliar2(double x) { return fabs(x) > 1e-8 ? expm1(x) / x : 1 + x / 2; }
+double zipfH(const DistribucionZipf& z, double x) { return exp(-z.s * log(x)); }
+double zipfHIntegral(const DistribucionZipf& z, double x) {
+    double logX = log(x);
+    return zipfAuxiliar2((1 - z.s) * logX) * logX;
+}
+double zipfHIntegralInversa(const DistribucionZipf& z, double x) {
+    double t = x * (1 - z.s);
+    if (t < -1) t = -1;
+    return exp(zipfAuxiliar1(t) * x);
+}
+
+DistribucionZipf crearZipf(int n, double s) {
+    DistribucionZipf z;
+    z.n = n > 0 ? n : 1;
+    z.s = s;
+    z.hIntegralX1 = zipfHIntegral(z, 1.5) - 1;
+    z.hIntegralN = zipfHIntegral(z, z.n + 0.5);
+    z.umbral = 2 - zipfHIntegralInversa(z, zipfHIntegral(z, 2.5) - zipfH(z, 2));
+    return z;
+}
+
+// Devuelve un rango en [1, n]; el rango 1 es el mas frecuente
+int muestrearZipf(const DistribucionZipf& z, mt19937_64& rng) {
+    uniform_real_distribution<double> uniforme(0.0, 1.0);
+    while (true) {
+        double u = z.hIntegralN + uniforme(rng) * (z.hIntegralX1 - z.hIntegralN);
+        double x = zipfHIntegralInversa(z, u);
+        int k = (int)(x + 0.5);
+        if (k < 1) k = 1;
+        else if (k > z.n) k = z.n;
+        if (k - x <= z.umbral || u >= zipfHIntegral(z, k + 0.5) - zipfH(z, k)) {
+            return k;
+        }
+    }
+}
+
+// Permutacion (rango -> indice) para que los mas frecuentes no sean siempre
+// los primeros IDs: multiplicar por un coprimo de n es una biyeccion.
+long multiplicadorPermutacion(long n) {
+    long m = 2654435761L % (n > 1 ? n : 2);
+    if (m < 1) m = 1;
+    auto mcd = [](long a, long b) { while (b) { long t = a % b; a = b; b = t; } return a; };
+    while (mcd(m, n) != 1) m++;
+    return m;
+}
+
+int elegirPonderado(const double* pesos, int cantidad, mt19937_64& rng) {
+    double total = 0;
+    for (int i = 0; i < cantidad; i++) total += pesos[i];
+    double r = uniform_real_distribution<double>(0.0, total)(rng);
+    for (int i = 0; i < cantidad; i++) {
+        if (r < pesos[i]) return i;
+        r -= pesos[i];
+    }
+    return cantidad - 1;
+}
+
+// Lunes a viernes; los sabados y domingos pasan al lunes siguiente
+Fecha diaHabilGen(Fecha dias) {
+    int diaSemana = diaDeSemana(dias);
+    if (diaSemana == 5) return dias + 2;
+    if (diaSemana == 6) return dias + 1;
+    return dias;
+}
+
+Hora horaGenerada(mt19937_64& rng) {
+    int bloque = (int)(rng() % 18);   // 08:00 a 16:30, cada 30 minutos
+    return (Hora)((8 + bloque / 2) * 60 + (bloque % 2) * 30);
+}
+
+// ============================================================================
+// EJECUCION PARALELA POR BLOQUES
+// ============================================================================
+
+// FUNCION: Repartir [0, total) en bloques entre hilos.
+// trabajo(inicio, fin, rng) recibe un generador propio de cada bloque.
+template<typename F>
+void ejecutarPorBloques(long total, int hilos, unsigned semilla, int etiqueta, F trabajo) {
+    long cantidadBloques = (total + BLOQUE_GENERADOR - 1) / BLOQUE_GENERADOR;
+    atomic<long> siguiente(0);
+
+    auto trabajador = [&]() {
+        long bloque;
+        while ((bloque = siguiente.fetch_add(1)) < cantidadBloques) {
+            seed_seq sembrado = {semilla, (unsigned)etiqueta, (unsigned)bloque, (unsigned)(bloque >> 32)};
+            mt19937_64 rng(sembrado);
+            long inicio = bloque * BLOQUE_GENERADOR;
+            long fin = inicio + BLOQUE_GENERADOR < total ? inicio + BLOQUE_GENERADOR : total;
+            trabajo(inicio, fin, rng);
+        }
+    };
+
+    vector<thread> grupo;
+    for (int i = 1; i < hilos; i++) grupo.push_back(thread(trabajador));
+    trabajador();
+    for (auto& t : grupo) t.join();
+}
+
+// FUNCION: Crear archivo con su header y dejarlo listo para escritura por bloques
+bool crearArchivoGenerado(const char* nombreArchivo, int cantidad) {
+    ofstream archivo(nombreArchivo, ios::binary | ios::trunc);
+    if (!archivo.is_open()) {
+        return false;
+    }
+
+    ArchivoHeader header;
+    header.cantidadRegistros = cantidad;
+    header.proximoID = cantidad + 1;
+    header.registrosActivos = cantidad;
+    header.version = VERSION_ACTUAL;
+    header.firma = nuevaFirmaArchivo();
+
+    archivo.write((char*)&header, sizeof(ArchivoHeader));
+    archivo.close();
+    return true;
+}
+
+// FUNCION: Generar y escribir los registros de un archivo en paralelo.
+// llenar(indice, rng, registro) completa un registro ya puesto en cero.
+template<typename T, typename F>
+bool escribirArchivoGenerado(const char* nombreArchivo, int cantidad, const ConfigGenerador& config,
+                             int etiqueta, F llenar) {
+    if (!crearArchivoGenerado(nombreArchivo, cantidad)) {
+        return false;
+    }
+
+    atomic<bool> ok(true);
+    ejecutarPorBloques(cantidad, config.hilos, config.semilla, etiqueta,
+        [&](long inicio, long fin, mt19937_64& rng) {
+            vector<T> buffer(fin - inicio);
+            for (long i = inicio; i < fin; i++) {
+                T& registro = buffer[i - inicio];
+                memset(&registro, 0, sizeof(T));
+                llenar((int)i, rng, registro);
+            }
+
+            fstream archivo(nombreArchivo, ios::binary | ios::in | ios::out);
+            if (!archivo.is_open()) {
+                ok = false;
+                return;
+            }
+            archivo.seekp(sizeof(ArchivoHeader) + inicio * (long)sizeof(T));
+            archivo.write((char*)buffer.data(), buffer.size() * sizeof(T));
+            archivo.close();
+        });
+    return ok;
+}
+
+// Listas compactas "padre -> hijos en orden de ID" (formato CSR)
+struct ListaRelaciones {
+    vector<int> inicio;     // inicio[p]..inicio[p+1] indexan a 'elementos'
+    vector<int> elementos;
+};
+
+ListaRelaciones agruparPorPadre(const vector<int>& padreDe, int cantidadPadres) {
+    ListaRelaciones lista;
+    lista.inicio.assign(cantidadPadres + 1, 0);
+    for (int padre : padreDe) lista.inicio[padre + 1]++;
+    for (int p = 0; p < cantidadPadres; p++) lista.inicio[p + 1] += lista.inicio[p];
+
+    lista.elementos.resize(padreDe.size());
+    vector<int> cursor(lista.inicio.begin(), lista.inicio.end() - 1);
+    for (size_t i = 0; i < padreDe.size(); i++) {
+        lista.elementos[cursor[padreDe[i]]++] = (int)i;
+    }
+    return lista;
+}
+
+// ============================================================================
+// GENERACION
+// ============================================================================
+
+ConfigGenerador configGeneradorPorDefecto() {
+    ConfigGenerador config;
+    config.pacientes = 1000;
+    config.doctores = 20;
+    config.citas = 3000;
+    config.consultas = 2000;
+    config.semilla = 42;
+    config.hilos = 0;
+    config.anioInicio = 2022;
+    config.anios = 4;
+    config.zipfPacientes = 1.1;
+    config.zipfDoctores = 0.7;
+    return config;
+}
+
+// FUNCION: Generar todos los archivos del sistema
+bool generarDatos(ConfigGenerador config) {
+    if (config.hilos <= 0) {
+        config.hilos = (int)thread::hardware_concurrency();
+        if (config.hilos <= 0) config.hilos = 1;
+    }
+    int nPacientes = config.pacientes > 0 ? config.pacientes : 1;
+    int nDoctores = config.doctores > 0 ? config.doctores : 1;
+    int nCitas = config.citas > 0 ? config.citas : 0;
+    int nConsultas = config.consultas > 0 ? config.consultas : 0;
+    descartarArchivosDerivados();
+
+    Fecha diaInicial = diasDesdeCivil(config.anioInicio, 1, 1);
+    int diasTotales = (config.anios > 0 ? config.anios : 1) * 365;
+    // Marcas de tiempo derivadas de las fechas para que la salida sea reproducible
+    time_t alta = (time_t)diaInicial * 86400;
+
+    DistribucionZipf zipfPacientes = crearZipf(nPacientes, config.zipfPacientes);
+    DistribucionZipf zipfDoctores = crearZipf(nDoctores, config.zipfDoctores);
+    long permPacientes = multiplicadorPermutacion(nPacientes);
+    long permDoctores = multiplicadorPermutacion(nDoctores);
+
+    auto pacienteZipf = [&](mt19937_64& rng) {
+        return (int)(((long)(muestrearZipf(zipfPacientes, rng) - 1) * permPacientes) % nPacientes);
+    };
+    auto doctorZipf = [&](mt19937_64& rng) {
+        return (int)(((long)(muestrearZipf(zipfDoctores, rng) - 1) * permDoctores) % nDoctores);
+    };
+    // Fecha cronologica segun la posicion del registro, con algo de ruido
+    auto diaSegunPosicion = [&](long i, long total, mt19937_64& rng) {
+        long base = total > 0 ? (long)diasTotales * i / total : 0;
+        return diaHabilGen(diaInicial + (int)base + (int)(rng() % 3));
+    };
+
+    // Asignacion (en paralelo): a que paciente y doctor pertenece cada registro
+    vector<int> pacienteDeCita(nCitas), doctorDeCita(nCitas);
+    ejecutarPorBloques(nCitas, config.hilos, config.semilla, ETQ_CITAS_ASIGNACION,
+        [&](long inicio, long fin, mt19937_64& rng) {
+            for (long i = inicio; i < fin; i++) {
+                pacienteDeCita[i] = pacienteZipf(rng);
+                doctorDeCita[i] = doctorZipf(rng);
+            }
+        });
+
+    vector<int> pacienteDeConsulta(nConsultas), doctorDeConsulta(nConsultas);
+    ejecutarPorBloques(nConsultas, config.hilos, config.semilla, ETQ_CONSULTAS_ASIGNACION,
+        [&](long inicio, long fin, mt19937_64& rng) {
+            for (long i = inicio; i < fin; i++) {
+                pacienteDeConsulta[i] = pacienteZipf(rng);
+                doctorDeConsulta[i] = doctorZipf(rng);
+            }
+        });
+
+    // Relaciones (secuencial, O(n)): citas por paciente/doctor y la lista
+    // enlazada de consultas de cada paciente en orden de ID
+    ListaRelaciones citasPorPaciente = agruparPorPadre(pacienteDeCita, nPacientes);
+    ListaRelaciones citasPorDoctor = agruparPorPadre(doctorDeCita, nDoctores);
+    ListaRelaciones consultasPorPaciente = agruparPorPadre(pacienteDeConsulta, nPacientes);
+    ListaRelaciones consultasPorDoctor = agruparPorPadre(doctorDeConsulta, nDoctores);
+
+    vector<int> siguienteConsulta(nConsultas, -1);
+    for (int p = 0; p < nPacientes; p++) {
+        for (int k = consultasPorPaciente.inicio[p]; k + 1 < consultasPorPaciente.inicio[p + 1]; k++) {
+            siguienteConsulta[consultasPorPaciente.elementos[k]] = consultasPorPaciente.elementos[k + 1] + 1;
+        }
+    }
+
+    // Especialidades: el codigo es la posicion en ESPECIALIDADES_GEN
+    vector<Diccionario> diccionarios(CANTIDAD_DICCIONARIOS);
+    for (int e = 0; e < cantidadGen(ESPECIALIDADES_GEN); e++) {
+        bool nueva;
+        agregarADiccionario(diccionarios[DICCIONARIO_ESPECIALIDADES], ESPECIALIDADES_GEN[e], nueva);
+    }
+    if (!escribirDiccionarios(ARCHIVO_DICCIONARIOS, diccionarios)) {
+        return false;
+    }
+
+    // Doctores: primero, porque las consultas copian su costo
+    vector<float> costoDoctor(nDoctores);
+    bool ok = escribirArchivoGenerado<Doctor>(ARCHIVO_DOCTORES, nDoctores, config, ETQ_DOCTORES,
+        [&](int i, mt19937_64& rng, Doctor& d) {
+            d.id = i + 1;
+            strcpy(d.nombre, NOMBRES_GEN[rng() % cantidadGen(NOMBRES_GEN)]);
+            strcpy(d.apellido, APELLIDOS_GEN[rng() % cantidadGen(APELLIDOS_GEN)]);
+            snprintf(d.cedulaProfesional, 20, "MED-%06d", d.id);
+            d.especialidad = (unsigned short)elegirPonderado(PESOS_ESPECIALIDADES_GEN,
+                             cantidadGen(ESPECIALIDADES_GEN), rng);
+            d.aniosExperiencia = 1 + (int)(rng() % 35);
+            d.costoConsulta = 20.0f + (float)(rng() % 16) * 5;
+            costoDoctor[i] = d.costoConsulta;
+            strcpy(d.horarioAtencion, HORARIOS_GEN[rng() % cantidadGen(HORARIOS_GEN)]);
+            snprintf(d.telefono, 15, "0414%07d", d.id % 10000000);
+            snprintf(d.email, 50, "doctor%d@hospital.com", d.id);
+            d.disponible = (rng() % 20) != 0;
+
+            for (int j = 0; j < MAX_PACIENTES_DOCTOR; j++) d.pacientesIDs[j] = -1;
+            for (int j = 0; j < MAX_CITAS_DOCTOR; j++) d.citasIDs[j] = -1;
+            for (int k = consultasPorDoctor.inicio[i]; k < consultasPorDoctor.inicio[i + 1] &&
+                 d.cantidadPacientes < MAX_PACIENTES_DOCTOR; k++) {
+                int pacienteID = pacienteDeConsulta[consultasPorDoctor.elementos[k]] + 1;
+                bool repetido = false;
+                for (int j = 0; j < d.cantidadPacientes && !repetido; j++) {
+                    repetido = d.pacientesIDs[j] == pacienteID;
+                }
+                if (!repetido) d.pacientesIDs[d.cantidadPacientes++] = pacienteID;
+            }
+            for (int k = citasPorDoctor.inicio[i]; k < citasPorDoctor.inicio[i + 1] &&
+                 d.cantidadCitas < MAX_CITAS_DOCTOR; k++) {
+                d.citasIDs[d.cantidadCitas++] = citasPorDoctor.elementos[k] + 1;
+            }
+
+            d.eliminado = false;
+            d.fechaCreacion = alta;
+            d.fechaModificacion = alta;
+        });
+
+    ok = ok && escribirArchivoGenerado<Paciente>(ARCHIVO_PACIENTES, nPacientes, config, ETQ_PACIENTES,
+        [&](int i, mt19937_64& rng, Paciente& p) {
+            p.id = i + 1;
+            strcpy(p.nombre, NOMBRES_GEN[rng() % cantidadGen(NOMBRES_GEN)]);
+            strcpy(p.apellido, APELLIDOS_GEN[rng() % cantidadGen(APELLIDOS_GEN)]);
+            snprintf(p.cedula, 20, "V-%08d", p.id);
+            // Piramide aproximada: mas jovenes que ancianos
+            p.edad = (int)(min(99.0, fabs(normal_distribution<double>(35.0, 22.0)(rng))));
+            p.sexo = (rng() % 2) ? 'M' : 'F';
+            const char* sangre = TIPOS_SANGRE_GEN[elegirPonderado(PESOS_TIPOS_SANGRE_GEN,
+                                 cantidadGen(TIPOS_SANGRE_GEN), rng)];
+            p.tipoSangre = (unsigned char)codigoTipoSangre(sangre, strlen(sangre));
+            snprintf(p.telefono, 15, "0424%07d", p.id % 10000000);
+            snprintf(p.direccion, 100, "Calle %d, Milagro", 1 + (int)(rng() % 200));
+            snprintf(p.email, 50, "paciente%d@correo.com", p.id);
+            strcpy(p.alergias, (rng() % 10) == 0 ? "Penicilina" : "Ninguna");
+            strcpy(p.observaciones, "");
+            p.activo = true;
+
+            p.cantidadConsultas = consultasPorPaciente.inicio[i + 1] - consultasPorPaciente.inicio[i];
+            p.primerConsultaID = p.cantidadConsultas > 0 ?
+                consultasPorPaciente.elementos[consultasPorPaciente.inicio[i]] + 1 : -1;
+
+            for (int j = 0; j < MAX_CITAS_PACIENTE; j++) p.citasIDs[j] = -1;
+            for (int k = citasPorPaciente.inicio[i]; k < citasPorPaciente.inicio[i + 1] &&
+                 p.cantidadCitas < MAX_CITAS_PACIENTE; k++) {
+                p.citasIDs[p.cantidadCitas++] = citasPorPaciente.elementos[k] + 1;
+            }
+
+            p.eliminado = false;
+            p.fechaCreacion = alta;
+            p.fechaModificacion = alta;
+        });
+
+    ok = ok && escribirArchivoGenerado<Cita>(ARCHIVO_CITAS, nCitas, config, ETQ_CITAS,
+        [&](int i, mt19937_64& rng, Cita& c) {
+            c.id = i + 1;
+            c.pacienteID = pacienteDeCita[i] + 1;
+            c.doctorID = doctorDeCita[i] + 1;
+            int dia = diaSegunPosicion(i, nCitas, rng);
+            c.fecha = dia;
+            c.hora = horaGenerada(rng);
+            strcpy(c.motivo, MOTIVOS_GEN[rng() % cantidadGen(MOTIVOS_GEN)]);
+            strcpy(c.observaciones, "");
+
+            // Las mas recientes siguen agendadas; el resto ya paso
+            int dado = (int)(rng() % 100);
+            if ((long)i * 20 >= (long)nCitas * 19) {
+                c.estado = dado < 8 ? CITA_CANCELADA : CITA_AGENDADA;
+            } else {
+                c.estado = dado < 12 ? CITA_CANCELADA : CITA_ATENDIDA;
+            }
+            c.consultaID = -1;
+            c.eliminado = false;
+            c.fechaCreacion = (time_t)(dia - 7) * 86400;
+            c.fechaModificacion = c.fechaCreacion;
+        });
+
+    ok = ok && escribirArchivoGenerado<HistorialMedico>(ARCHIVO_HISTORIALES, nConsultas, config, ETQ_CONSULTAS,
+        [&](int i, mt19937_64& rng, HistorialMedico& h) {
+            h.id = i + 1;
+            h.pacienteID = pacienteDeConsulta[i] + 1;
+            h.doctorID = doctorDeConsulta[i] + 1;
+            int dia = diaSegunPosicion(i, nConsultas, rng);
+            h.fecha = dia;
+            h.hora = horaGenerada(rng);
+            strcpy(h.diagnostico, DIAGNOSTICOS_GEN[rng() % cantidadGen(DIAGNOSTICOS_GEN)]);
+            strcpy(h.tratamiento, TRATAMIENTOS_GEN[rng() % cantidadGen(TRATAMIENTOS_GEN)]);
+            strcpy(h.medicamentos, MEDICAMENTOS_GEN[rng() % cantidadGen(MEDICAMENTOS_GEN)]);
+            h.costo = costoDoctor[h.doctorID - 1];
+            h.siguienteConsultaID = siguienteConsulta[i];
+            h.eliminado = false;
+            h.fechaRegistro = (time_t)dia * 86400;
+        });
+
+    if (!ok) {
+        return false;
+    }
+
+    // Datos del hospital coherentes con los headers
+    Hospital hospital;
+    memset(&hospital, 0, sizeof(Hospital));
+    strcpy(hospital.nombre, "Hospital Central");
+    strcpy(hospital.direccion, "Av. Principal Milagro");
+    strcpy(hospital.telefono, "555-1234");
+    hospital.siguienteIDPaciente = nPacientes + 1;
+    hospital.siguienteIDDoctor = nDoctores + 1;
+    hospital.siguienteIDCita = nCitas + 1;
+    hospital.siguienteIDConsulta = nConsultas + 1;
+    hospital.totalPacientesRegistrados = nPacientes;
+    hospital.totalDoctoresRegistrados = nDoctores;
+    hospital.totalCitasAgendadas = nCitas;
+    hospital.totalConsultasRealizadas = nConsultas;
+
+    ofstream archivo(ARCHIVO_HOSPITAL, ios::binary | ios::trunc);
+    if (!archivo.is_open()) {
+        return false;
+    }
+    archivo.write((char*)&hospital, sizeof(Hospital));
+    archivo.close();
+    return true;
+}
+
+#endif //GENERADOR_H
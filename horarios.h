@@ -0,0 +1,158 @@
+#ifndef HORARIOS_H
+#define HORARIOS_H
+
+#include <cstring>
+#include "fecha.h"
+#include "texto.h"
+
+using namespace std;
+
+// ============================================================================
+// HORARIOS DE ATENCION
+// ============================================================================
+// Doctor::horarioAtencion es texto libre ("Lun-Vie 08:00-16:00"). Aqui se
+// convierte en una plantilla semanal: por dia, una palabra de 64 bits con un
+// bit por turno de 30 minutos (48 turnos). Con la ocupacion del dia en el
+// mismo formato, los turnos libres son plantilla & ~ocupados y el primero
+// sale con un ctz, sin probar hora por hora.
+//
+// Formato aceptado (sin importar mayusculas ni acentos):
+//   dias horas [horas...] [; dias horas [horas...]]
+//   dias:  "Lun", "Lun-Vie" (dos dias: rango) o "Lun-Mie-Vie" (tres o mas: lista)
+//   horas: "08:00-12:00" (el turno que empieza a la hora final no se incluye)
+// Los segmentos se separan con ';' o ','. Ejemplo: "Lun-Vie 08:00-12:00 14:00-18:00; Sab 09:00-12:00"
+
+const int MINUTOS_POR_TURNO = 30;
+const int TURNOS_POR_DIA = MINUTOS_POR_DIA / MINUTOS_POR_TURNO;
+
+typedef unsigned long long MascaraTurnos;   // Bit i: turno que empieza a las i * 30 minutos
+
+struct PlantillaSemanal {
+    MascaraTurnos dias[7];                  // 0 = lunes (como diaDeSemana)
+};
+
+inline int turnoDeHora(Hora hora) {
+    return hora / MINUTOS_POR_TURNO;
+}
+
+inline Hora horaDeTurno(int turno) {
+    return (Hora)(turno * MINUTOS_POR_TURNO);
+}
+
+// Turnos [desde, hasta) de un dia
+inline MascaraTurnos mascaraTurnos(int desde, int hasta) {
+    if (desde < 0) desde = 0;
+    if (hasta > TURNOS_POR_DIA) hasta = TURNOS_POR_DIA;
+    if (hasta <= desde) return 0;
+    return ((~0ULL) >> (64 - (hasta - desde))) << desde;
+}
+
+// Primeras tres letras normalizadas de cada dia ("Miercoles", "mie" o con acento dan MIE)
+const char* ABREVIATURAS_DIA[] = {"LUN", "MAR", "MIE", "JUE", "VIE", "SAB", "DOM"};
+
+// FUNCION: Leer un nombre de dia y avanzar p (-1 si no es un dia)
+int leerDiaSemana(const char*& p) {
+    char palabra[4] = {0, 0, 0, 0};
+    int largo = 0;
+    while (*p != '\0') {
+        unsigned char c = *p;
+        int bytes = 1;
+        // UTF-8: C3 xx corresponde a Latin-1 xx + 0x40 (igual que normalizarTexto)
+        if (c == 0xC3 && (unsigned char)p[1] >= 0x80 && (unsigned char)p[1] <= 0xBF) {
+            c = (unsigned char)(p[1] + 0x40);
+            bytes = 2;
+        }
+        char plegado = plegarCaracter(c);
+        if (plegado < 'A' || plegado > 'Z') break;
+        if (largo < 3) palabra[largo] = plegado;
+        largo++;
+        p += bytes;
+    }
+    if (largo < 3) return -1;
+    for (int dia = 0; dia < 7; dia++) {
+        if (strcmp(palabra, ABREVIATURAS_DIA[dia]) == 0) return dia;
+    }
+    return -1;
+}
+
+// FUNCION: Leer "H:MM" o "HH:MM" (hasta 24:00) y avanzar p
+bool leerHoraHorario(const char*& p, Hora& hora) {
+    int horas = 0, minutos = 0, digitos = 0;
+    const char* q = p;
+    while (*q >= '0' && *q <= '9' && digitos < 2) {
+        horas = horas * 10 + (*q++ - '0');
+        digitos++;
+    }
+    if (digitos == 0 || *q != ':' || q[1] < '0' || q[1] > '5' || q[2] < '0' || q[2] > '9') {
+        return false;
+    }
+    minutos = (q[1] - '0') * 10 + (q[2] - '0');
+    if (horas > 24 || (horas == 24 && minutos > 0)) return false;
+    hora = (Hora)(horas * 60 + minutos);
+    p = q + 3;
+    return true;
+}
+
+// FUNCION: Convertir un horario de texto en plantilla semanal.
+// false si el texto no sigue el formato (la plantilla queda vacia).
+bool parsearHorario(const char* texto, PlantillaSemanal& plantilla) {
+    memset(&plantilla, 0, sizeof(PlantillaSemanal));
+    const char* p = texto;
+    bool hayTurnos = false;
+
+    while (true) {
+        while (*p == ' ' || *p == '\t' || *p == ';' || *p == ',') p++;
+        if (*p == '\0') break;
+
+        // Dias del segmento
+        int dias[7];
+        int cantidad = 0;
+        do {
+            if (cantidad > 0) p++;                  // '-'
+            int dia = leerDiaSemana(p);
+            if (dia < 0 || cantidad == 7) {
+                memset(&plantilla, 0, sizeof(PlantillaSemanal));
+                return false;
+            }
+            dias[cantidad++] = dia;
+        } while (*p == '-');
+
+        unsigned int diasSegmento = 0;
+        if (cantidad == 2) {
+            // Rango; puede pasar por el domingo ("Sab-Lun")
+            for (int dia = dias[0]; ; dia = (dia + 1) % 7) {
+                diasSegmento |= 1u << dia;
+                if (dia == dias[1]) break;
+            }
+        } else {
+            for (int i = 0; i < cantidad; i++) diasSegmento |= 1u << dias[i];
+        }
+
+        // Uno o mas rangos de horas
+        int rangos = 0;
+        while (true) {
+            while (*p == ' ' || *p == '\t') p++;
+            Hora inicio, fin;
+            if (!leerHoraHorario(p, inicio)) break;
+            if (*p != '-' || !leerHoraHorario(++p, fin) || fin <= inicio) {
+                memset(&plantilla, 0, sizeof(PlantillaSemanal));
+                return false;
+            }
+            // Solo turnos completos dentro del rango
+            MascaraTurnos turnos = mascaraTurnos((inicio + MINUTOS_POR_TURNO - 1) / MINUTOS_POR_TURNO,
+                                                 fin / MINUTOS_POR_TURNO);
+            for (int dia = 0; dia < 7; dia++) {
+                if (diasSegmento & (1u << dia)) plantilla.dias[dia] |= turnos;
+            }
+            rangos++;
+        }
+        if (rangos == 0) {
+            memset(&plantilla, 0, sizeof(PlantillaSemanal));
+            return false;
+        }
+        hayTurnos = true;
+    }
+    return hayTurnos;
+}
+
+#endif //HORARIOS_H
@@ -0,0 +1,309 @@
+#ifndef INDICE_BITS_H
+#define INDICE_BITS_H
+
+#include <istream>
+#include <ostream>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+// ============================================================================
+// MAPAS DE BITS COMPRIMIDOS
+// ============================================================================
+// Conjunto de posiciones de registro al estilo "roaring": los 16 bits altos
+// de la posicion eligen un contenedor y el contenedor guarda los 16 bits
+// bajos de una de dos formas, segun cuantos tenga:
+//
+// - Arreglo ordenado de unsigned short (hasta 4096 valores, 2 bytes c/u).
+// - Mapa de 65536 bits en 1024 palabras de 64 bits (8 KB fijos).
+//
+// Con 4096 valores las dos formas ocupan lo mismo, por eso ese es el corte.
+// AND y OR trabajan contenedor por contenedor con la combinacion de formas
+// que toque, y la cantidad de un mapa es la suma de las de sus contenedores
+// (popcount en los de forma mapa) sin recorrer los valores.
+//
+// En disco: [cantidadContenedores] y por contenedor [clave][cantidad]
+// seguido de los valores o de las palabras (la forma sale de la cantidad).
+
+const int MAX_VALORES_ARREGLO_BITS = 4096;
+const int PALABRAS_CONTENEDOR_BITS = 1024;
+
+struct ContenedorBits {
+    unsigned short clave;                   // 16 bits altos
+    int cantidad;
+    vector<unsigned short> valores;         // Forma arreglo (vacio en forma mapa)
+    vector<unsigned long long> palabras;    // Forma mapa (vacio en forma arreglo)
+};
+
+struct MapaBits {
+    vector<ContenedorBits> contenedores;    // En orden de clave, ninguno vacio
+};
+
+bool esFormaMapa(const ContenedorBits& c) {
+    return !c.palabras.empty();
+}
+
+bool bitEnPalabras(const vector<unsigned long long>& palabras, unsigned short valor) {
+    return (palabras[valor >> 6] >> (valor & 63)) & 1;
+}
+
+// FUNCION: Pasar un contenedor a la forma que le corresponde por su cantidad
+void ajustarContenedorBits(ContenedorBits& c) {
+    if (esFormaMapa(c) && c.cantidad <= MAX_VALORES_ARREGLO_BITS) {
+        c.valores.clear();
+        c.valores.reserve(c.cantidad);
+        for (int w = 0; w < PALABRAS_CONTENEDOR_BITS; w++) {
+            for (unsigned long long palabra = c.palabras[w]; palabra != 0; palabra &= palabra - 1) {
+                c.valores.push_back((unsigned short)(w * 64 + __builtin_ctzll(palabra)));
+            }
+        }
+        vector<unsigned long long>().swap(c.palabras);
+    } else if (!esFormaMapa(c) && c.cantidad > MAX_VALORES_ARREGLO_BITS) {
+        c.palabras.assign(PALABRAS_CONTENEDOR_BITS, 0);
+        for (unsigned short valor : c.valores) {
+            c.palabras[valor >> 6] |= 1ULL << (valor & 63);
+        }
+        vector<unsigned short>().swap(c.valores);
+    }
+}
+
+// Posicion del contenedor con esa clave, o donde iria si no existe
+size_t posicionContenedorBits(const MapaBits& mapa, unsigned short clave) {
+    auto encontrado = lower_bound(mapa.contenedores.begin(), mapa.contenedores.end(), clave,
+                                  [](const ContenedorBits& c, unsigned short k) { return c.clave < k; });
+    return encontrado - mapa.contenedores.begin();
+}
+
+bool contieneBit(const MapaBits& mapa, unsigned int posicion) {
+    unsigned short clave = (unsigned short)(posicion >> 16), valor = (unsigned short)posicion;
+    size_t i = posicionContenedorBits(mapa, clave);
+    if (i == mapa.contenedores.size() || mapa.contenedores[i].clave != clave) {
+        return false;
+    }
+    const ContenedorBits& c = mapa.contenedores[i];
+    return esFormaMapa(c) ? bitEnPalabras(c.palabras, valor)
+                          : binary_search(c.valores.begin(), c.valores.end(), valor);
+}
+
+// FUNCION: Agregar una posicion (no hace nada si ya estaba)
+void agregarBit(MapaBits& mapa, unsigned int posicion) {
+    unsigned short clave = (unsigned short)(posicion >> 16), valor = (unsigned short)posicion;
+    size_t i = posicionContenedorBits(mapa, clave);
+    if (i == mapa.contenedores.size() || mapa.contenedores[i].clave != clave) {
+        ContenedorBits nuevo;
+        nuevo.clave = clave;
+        nuevo.cantidad = 0;
+        mapa.contenedores.insert(mapa.contenedores.begin() + i, nuevo);
+    }
+
+    ContenedorBits& c = mapa.contenedores[i];
+    if (esFormaMapa(c)) {
+        if (bitEnPalabras(c.palabras, valor)) return;
+        c.palabras[valor >> 6] |= 1ULL << (valor & 63);
+    } else {
+        auto lugar = lower_bound(c.valores.begin(), c.valores.end(), valor);
+        if (lugar != c.valores.end() && *lugar == valor) return;
+        c.valores.insert(lugar, valor);
+    }
+    c.cantidad++;
+    ajustarContenedorBits(c);
+}
+
+// FUNCION: Quitar una posicion (no hace nada si no estaba)
+void quitarBit(MapaBits& mapa, unsigned int posicion) {
+    unsigned short clave = (unsigned short)(posicion >> 16), valor = (unsigned short)posicion;
+    size_t i = posicionContenedorBits(mapa, clave);
+    if (i == mapa.contenedores.size() || mapa.contenedores[i].clave != clave) {
+        return;
+    }
+
+    ContenedorBits& c = mapa.contenedores[i];
+    if (esFormaMapa(c)) {
+        if (!bitEnPalabras(c.palabras, valor)) return;
+        c.palabras[valor >> 6] &= ~(1ULL << (valor & 63));
+    } else {
+        auto lugar = lower_bound(c.valores.begin(), c.valores.end(), valor);
+        if (lugar == c.valores.end() || *lugar != valor) return;
+        c.valores.erase(lugar);
+    }
+    if (--c.cantidad == 0) {
+        mapa.contenedores.erase(mapa.contenedores.begin() + i);
+    } else {
+        ajustarContenedorBits(c);
+    }
+}
+
+long cantidadBits(const MapaBits& mapa) {
+    long total = 0;
+    for (const ContenedorBits& c : mapa.contenedores) total += c.cantidad;
+    return total;
+}
+
+// ============================================================================
+// AND / OR
+// ============================================================================
+
+ContenedorBits interseccionContenedores(const ContenedorBits& a, const ContenedorBits& b) {
+    ContenedorBits r;
+    r.clave = a.clave;
+    r.cantidad = 0;
+
+    if (esFormaMapa(a) && esFormaMapa(b)) {
+        r.palabras.resize(PALABRAS_CONTENEDOR_BITS);
+        for (int w = 0; w < PALABRAS_CONTENEDOR_BITS; w++) {
+            r.palabras[w] = a.palabras[w] & b.palabras[w];
+            r.cantidad += __builtin_popcountll(r.palabras[w]);
+        }
+        ajustarContenedorBits(r);
+    } else if (!esFormaMapa(a) && !esFormaMapa(b)) {
+        r.valores.reserve(min(a.cantidad, b.cantidad));
+        set_intersection(a.valores.begin(), a.valores.end(), b.valores.begin(), b.valores.end(),
+                         back_inserter(r.valores));
+        r.cantidad = (int)r.valores.size();
+    } else {
+        const ContenedorBits& arreglo = esFormaMapa(a) ? b : a;
+        const ContenedorBits& mapa = esFormaMapa(a) ? a : b;
+        for (unsigned short valor : arreglo.valores) {
+            if (bitEnPalabras(mapa.palabras, valor)) r.valores.push_back(valor);
+        }
+        r.cantidad = (int)r.valores.size();
+    }
+    return r;
+}
+
+ContenedorBits unionContenedores(const ContenedorBits& a, const ContenedorBits& b) {
+    ContenedorBits r;
+    r.clave = a.clave;
+
+    if (!esFormaMapa(a) && !esFormaMapa(b) && a.cantidad + b.cantidad <= MAX_VALORES_ARREGLO_BITS) {
+        r.valores.reserve(a.cantidad + b.cantidad);
+        set_union(a.valores.begin(), a.valores.end(), b.valores.begin(), b.valores.end(),
+                  back_inserter(r.valores));
+        r.cantidad = (int)r.valores.size();
+        return r;
+    }
+
+    r.palabras.assign(PALABRAS_CONTENEDOR_BITS, 0);
+    for (const ContenedorBits* c : {&a, &b}) {
+        if (esFormaMapa(*c)) {
+            for (int w = 0; w < PALABRAS_CONTENEDOR_BITS; w++) r.palabras[w] |= c->palabras[w];
+        } else {
+            for (unsigned short valor : c->valores) r.palabras[valor >> 6] |= 1ULL << (valor & 63);
+        }
+    }
+    r.cantidad = 0;
+    for (int w = 0; w < PALABRAS_CONTENEDOR_BITS; w++) r.cantidad += __builtin_popcountll(r.palabras[w]);
+    ajustarContenedorBits(r);
+    return r;
+}
+
+MapaBits interseccionMapas(const MapaBits& a, const MapaBits& b) {
+    MapaBits r;
+    size_t i = 0, j = 0;
+    while (i < a.contenedores.size() && j < b.contenedores.size()) {
+        if (a.contenedores[i].clave < b.contenedores[j].clave) {
+            i++;
+        } else if (b.contenedores[j].clave < a.contenedores[i].clave) {
+            j++;
+        } else {
+            ContenedorBits c = interseccionContenedores(a.contenedores[i++], b.contenedores[j++]);
+            if (c.cantidad > 0) r.contenedores.push_back(move(c));
+        }
+    }
+    return r;
+}
+
+MapaBits unionMapas(const MapaBits& a, const MapaBits& b) {
+    MapaBits r;
+    size_t i = 0, j = 0;
+    while (i < a.contenedores.size() || j < b.contenedores.size()) {
+        if (j == b.contenedores.size() ||
+            (i < a.contenedores.size() && a.contenedores[i].clave < b.contenedores[j].clave)) {
+            r.contenedores.push_back(a.contenedores[i++]);
+        } else if (i == a.contenedores.size() || b.contenedores[j].clave < a.contenedores[i].clave) {
+            r.contenedores.push_back(b.contenedores[j++]);
+        } else {
+            r.contenedores.push_back(unionContenedores(a.contenedores[i++], b.contenedores[j++]));
+        }
+    }
+    return r;
+}
+
+// FUNCION: Recorrer las posiciones en orden creciente; visitar devuelve
+// false para cortar
+template<typename Visitar>
+void recorrerMapaBits(const MapaBits& mapa, Visitar visitar) {
+    for (const ContenedorBits& c : mapa.contenedores) {
+        unsigned int alto = (unsigned int)c.clave << 16;
+        if (esFormaMapa(c)) {
+            for (int w = 0; w < PALABRAS_CONTENEDOR_BITS; w++) {
+                for (unsigned long long palabra = c.palabras[w]; palabra != 0; palabra &= palabra - 1) {
+                    if (!visitar(alto | (unsigned int)(w * 64 + __builtin_ctzll(palabra)))) return;
+                }
+            }
+        } else {
+            for (unsigned short valor : c.valores) {
+                if (!visitar(alto | valor)) return;
+            }
+        }
+    }
+}
+
+// ============================================================================
+// LECTURA Y ESCRITURA
+// ============================================================================
+
+// FUNCION: Escribir un mapa; devuelve los bytes escritos
+size_t escribirMapaBits(ostream& salida, const MapaBits& mapa) {
+    int cantidadContenedores = (int)mapa.contenedores.size();
+    salida.write((const char*)&cantidadContenedores, sizeof(int));
+    size_t bytes = sizeof(int);
+    for (const ContenedorBits& c : mapa.contenedores) {
+        salida.write((const char*)&c.clave, sizeof(unsigned short));
+        salida.write((const char*)&c.cantidad, sizeof(int));
+        if (esFormaMapa(c)) {
+            salida.write((const char*)c.palabras.data(), PALABRAS_CONTENEDOR_BITS * sizeof(unsigned long long));
+            bytes += PALABRAS_CONTENEDOR_BITS * sizeof(unsigned long long);
+        } else {
+            salida.write((const char*)c.valores.data(), c.valores.size() * sizeof(unsigned short));
+            bytes += c.valores.size() * sizeof(unsigned short);
+        }
+        bytes += sizeof(unsigned short) + sizeof(int);
+    }
+    return bytes;
+}
+
+// FUNCION: Leer un mapa escrito con escribirMapaBits (false si esta truncado
+// o no tiene sentido); devuelve en bytes lo leido
+bool leerMapaBits(istream& entrada, MapaBits& mapa, size_t& bytes) {
+    mapa.contenedores.clear();
+    int cantidadContenedores;
+    entrada.read((char*)&cantidadContenedores, sizeof(int));
+    bytes = sizeof(int);
+    if (!entrada || cantidadContenedores < 0 || cantidadContenedores > 65536) {
+        return false;
+    }
+
+    mapa.contenedores.resize(cantidadContenedores);
+    for (ContenedorBits& c : mapa.contenedores) {
+        entrada.read((char*)&c.clave, sizeof(unsigned short));
+        entrada.read((char*)&c.cantidad, sizeof(int));
+        if (!entrada || c.cantidad < 1 || c.cantidad > 65536) {
+            return false;
+        }
+        if (c.cantidad > MAX_VALORES_ARREGLO_BITS) {
+            c.palabras.resize(PALABRAS_CONTENEDOR_BITS);
+            entrada.read((char*)c.palabras.data(), PALABRAS_CONTENEDOR_BITS * sizeof(unsigned long long));
+            bytes += PALABRAS_CONTENEDOR_BITS * sizeof(unsigned long long);
+        } else {
+            c.valores.resize(c.cantidad);
+            entrada.read((char*)c.valores.data(), c.cantidad * sizeof(unsigned short));
+            bytes += c.cantidad * sizeof(unsigned short);
+        }
+        bytes += sizeof(unsigned short) + sizeof(int);
+    }
+    return (bool)entrada;
+}
+
+#endif //INDICE_BITS_H
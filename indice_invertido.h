@@ -0,0 +1,438 @@
+#ifndef INDICE_INVERTIDO_H
+#define INDICE_INVERTIDO_H
+
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <mutex>
+#include <algorithm>
+#include "metricas.h"
+
+using namespace std;
+
+// ============================================================================
+// INDICE INVERTIDO PERSISTENTE
+// ============================================================================
+// Asocia cada termino con la lista ordenada de IDs de los documentos que lo
+// contienen. Usa dos archivos:
+//
+// - Terminos:  [CabeceraIndiceInvertido][TerminoInvertido x cantidadTerminos]
+//   Se carga completo en memoria (un diccionario tiene pocos miles de terminos).
+// - Postings:  bloques [CabeceraBloquePostings][datos] enlazados por termino.
+//   Los IDs van como diferencias con el anterior en varint (1 byte casi
+//   siempre). Cada bloque nuevo de un termino duplica la capacidad del
+//   anterior hasta 4 KB, asi una lista larga se lee en pocas lecturas.
+//
+// Los documentos se agregan en orden creciente de ID (archivos de solo
+// agregado), por eso agregar es escribir al final del ultimo bloque. La
+// cabecera guarda la firma del header del archivo de datos indexado.
+
+const int VERSION_INDICE_INVERTIDO = 2;
+const int LARGO_TERMINO = 24;
+const int BLOQUE_POSTINGS_MINIMO = 64;
+const int BLOQUE_POSTINGS_MAXIMO = 4096;
+
+struct CabeceraIndiceInvertido {
+    int version;
+    int cantidadTerminos;
+    int registrosCubiertos;     // cantidadRegistros del archivo de datos indexado
+    int cantidadDocumentos;
+    unsigned long long firmaDatos;  // firma del header del archivo de datos indexado
+};
+
+struct TerminoInvertido {
+    char termino[LARGO_TERMINO];
+    long long primerBloque;     // Posicion en el archivo de postings
+    long long ultimoBloque;
+    int ultimoID;
+    int cantidad;               // Documentos que contienen el termino
+    int capacidadUltimo;        // Copia del ultimo bloque, para agregar sin leerlo
+    int usadosUltimo;
+};
+
+struct CabeceraBloquePostings {
+    long long siguiente;        // -1 si es el ultimo
+    int capacidad;              // Bytes de datos
+    int usados;
+};
+
+// ============================================================================
+// VARINT
+// ============================================================================
+
+int codificarVarint(unsigned int valor, unsigned char* destino) {
+    int largo = 0;
+    while (valor >= 0x80) {
+        destino[largo++] = (unsigned char)(valor | 0x80);
+        valor >>= 7;
+    }
+    destino[largo++] = (unsigned char)valor;
+    return largo;
+}
+
+// Decodifica las diferencias de un bloque y las agrega a ids
+void decodificarPostings(const unsigned char* datos, int usados, int& ultimoID, vector<int>& ids) {
+    int i = 0;
+    while (i < usados) {
+        unsigned int valor = 0;
+        int desplazamiento = 0;
+        while (datos[i] & 0x80) {
+            valor |= (unsigned int)(datos[i++] & 0x7F) << desplazamiento;
+            desplazamiento += 7;
+        }
+        valor |= (unsigned int)datos[i++] << desplazamiento;
+        ultimoID += (int)valor;
+        ids.push_back(ultimoID);
+    }
+}
+
+// ============================================================================
+// DICCIONARIO EN MEMORIA
+// ============================================================================
+
+struct DiccionarioInvertido {
+    bool cargado;
+    CabeceraIndiceInvertido cabecera;
+    vector<TerminoInvertido> terminos;
+    unordered_map<string, int> posiciones;
+};
+
+mutex candadoIndiceInvertido;
+
+DiccionarioInvertido& diccionarioInvertido(const char* archivoTerminos) {
+    static map<string, DiccionarioInvertido> diccionarios;
+    return diccionarios[archivoTerminos];
+}
+
+long posicionTerminoInvertido(int posicion) {
+    return sizeof(CabeceraIndiceInvertido) + (long)posicion * sizeof(TerminoInvertido);
+}
+
+// FUNCION: Leer la cabecera del archivo de terminos (false si no existe o no es compatible)
+bool leerCabeceraIndiceInvertido(const char* archivoTerminos, CabeceraIndiceInvertido& cabecera) {
+    ifstream entrada(archivoTerminos, ios::binary);
+    METRICA_APERTURA();
+    if (!entrada.is_open()) {
+        return false;
+    }
+    entrada.read((char*)&cabecera, sizeof(CabeceraIndiceInvertido));
+    METRICA_LECTURA(sizeof(CabeceraIndiceInvertido));
+    return entrada.gcount() == sizeof(CabeceraIndiceInvertido) &&
+           cabecera.version == VERSION_INDICE_INVERTIDO;
+}
+
+// FUNCION: Cargar el diccionario si cambio en disco (sin candado)
+bool refrescarDiccionarioInvertido(const char* archivoTerminos, DiccionarioInvertido& d) {
+    CabeceraIndiceInvertido cabecera;
+    if (!leerCabeceraIndiceInvertido(archivoTerminos, cabecera)) {
+        d.cargado = false;
+        return false;
+    }
+    if (d.cargado && cabecera.cantidadTerminos == d.cabecera.cantidadTerminos &&
+        cabecera.registrosCubiertos == d.cabecera.registrosCubiertos &&
+        cabecera.firmaDatos == d.cabecera.firmaDatos &&
+        cabecera.cantidadDocumentos == d.cabecera.cantidadDocumentos) {
+        return true;
+    }
+
+    ifstream entrada(archivoTerminos, ios::binary);
+    METRICA_APERTURA();
+    d.terminos.resize(cabecera.cantidadTerminos);
+    entrada.seekg(sizeof(CabeceraIndiceInvertido));
+    METRICA_POSICIONAMIENTO();
+    entrada.read((char*)d.terminos.data(), d.terminos.size() * sizeof(TerminoInvertido));
+    METRICA_LECTURA(d.terminos.size() * sizeof(TerminoInvertido));
+    if (!entrada) {
+        d.cargado = false;
+        return false;
+    }
+
+    d.posiciones.clear();
+    for (int i = 0; i < cabecera.cantidadTerminos; i++) {
+        d.posiciones[d.terminos[i].termino] = i;
+    }
+    d.cabecera = cabecera;
+    d.cargado = true;
+    return true;
+}
+
+// ============================================================================
+// CONSTRUCCION Y MANTENIMIENTO
+// ============================================================================
+
+// FUNCION: Escribir un indice completo (reemplaza el existente).
+// listas: termino -> IDs en orden creciente.
+bool crearIndiceInvertido(const char* archivoTerminos, const char* archivoPostings,
+                          const map<string, vector<int>>& listas, int registrosCubiertos,
+                          unsigned long long firmaDatos, int cantidadDocumentos) {
+    lock_guard<mutex> guardia(candadoIndiceInvertido);
+
+    string temporalTerminos = string(archivoTerminos) + ".tmp";
+    string temporalPostings = string(archivoPostings) + ".tmp";
+    ofstream terminos(temporalTerminos.c_str(), ios::binary);
+    ofstream postings(temporalPostings.c_str(), ios::binary);
+    METRICA_APERTURA();
+    METRICA_APERTURA();
+    if (!terminos.is_open() || !postings.is_open()) {
+        return false;
+    }
+
+    CabeceraIndiceInvertido cabecera;
+    cabecera.version = VERSION_INDICE_INVERTIDO;
+    cabecera.cantidadTerminos = (int)listas.size();
+    cabecera.registrosCubiertos = registrosCubiertos;
+    cabecera.cantidadDocumentos = cantidadDocumentos;
+    cabecera.firmaDatos = firmaDatos;
+    terminos.write((char*)&cabecera, sizeof(CabeceraIndiceInvertido));
+    METRICA_ESCRITURA(sizeof(CabeceraIndiceInvertido));
+
+    // Cada lista reconstruida va en un solo bloque de su tamanio exacto
+    long long posicion = 0;
+    vector<unsigned char> datos;
+    for (const auto& lista : listas) {
+        datos.clear();
+        int anterior = 0;
+        unsigned char varint[5];
+        for (int id : lista.second) {
+            int largo = codificarVarint((unsigned int)(id - anterior), varint);
+            datos.insert(datos.end(), varint, varint + largo);
+            anterior = id;
+        }
+
+        CabeceraBloquePostings bloque;
+        bloque.siguiente = -1;
+        bloque.capacidad = max((int)datos.size(), BLOQUE_POSTINGS_MINIMO);
+        bloque.usados = (int)datos.size();
+        datos.resize(bloque.capacidad, 0);
+        postings.write((char*)&bloque, sizeof(CabeceraBloquePostings));
+        postings.write((char*)datos.data(), datos.size());
+        METRICA_ESCRITURA(sizeof(CabeceraBloquePostings) + datos.size());
+
+        TerminoInvertido t;
+        memset(&t, 0, sizeof(TerminoInvertido));
+        strncpy(t.termino, lista.first.c_str(), LARGO_TERMINO - 1);
+        t.primerBloque = t.ultimoBloque = posicion;
+        t.ultimoID = anterior;
+        t.cantidad = (int)lista.second.size();
+        t.capacidadUltimo = bloque.capacidad;
+        t.usadosUltimo = bloque.usados;
+        terminos.write((char*)&t, sizeof(TerminoInvertido));
+        METRICA_ESCRITURA(sizeof(TerminoInvertido));
+
+        posicion += sizeof(CabeceraBloquePostings) + bloque.capacidad;
+    }
+
+    terminos.close();
+    postings.close();
+    if (!terminos || !postings) {
+        remove(temporalTerminos.c_str());
+        remove(temporalPostings.c_str());
+        return false;
+    }
+
+    remove(archivoTerminos);
+    remove(archivoPostings);
+    diccionarioInvertido(archivoTerminos).cargado = false;
+    return rename(temporalPostings.c_str(), archivoPostings) == 0 &&
+           rename(temporalTerminos.c_str(), archivoTerminos) == 0;
+}
+
+// FUNCION: Agregar un documento con sus terminos. El ID debe ser mayor que
+// todos los ya indexados; registrosCubiertos es el nuevo total del archivo de datos.
+bool agregarDocumentoInvertido(const char* archivoTerminos, const char* archivoPostings,
+                               int id, vector<string> terminosDocumento, int registrosCubiertos) {
+    lock_guard<mutex> guardia(candadoIndiceInvertido);
+
+    DiccionarioInvertido& d = diccionarioInvertido(archivoTerminos);
+    if (!refrescarDiccionarioInvertido(archivoTerminos, d)) {
+        return false;
+    }
+
+    fstream terminos(archivoTerminos, ios::binary | ios::in | ios::out);
+    fstream postings(archivoPostings, ios::binary | ios::in | ios::out);
+    METRICA_APERTURA();
+    METRICA_APERTURA();
+    if (!terminos.is_open() || !postings.is_open()) {
+        return false;
+    }
+    postings.seekp(0, ios::end);
+    METRICA_POSICIONAMIENTO();
+    long long finPostings = postings.tellp();
+
+    sort(terminosDocumento.begin(), terminosDocumento.end());
+    terminosDocumento.erase(unique(terminosDocumento.begin(), terminosDocumento.end()), terminosDocumento.end());
+
+    for (const string& termino : terminosDocumento) {
+        auto encontrado = d.posiciones.find(termino.substr(0, LARGO_TERMINO - 1));
+        int posicion;
+        unsigned char varint[5];
+
+        if (encontrado == d.posiciones.end()) {
+            // Termino nuevo: bloque minimo al final del archivo
+            TerminoInvertido t;
+            memset(&t, 0, sizeof(TerminoInvertido));
+            strncpy(t.termino, termino.c_str(), LARGO_TERMINO - 1);
+            t.primerBloque = t.ultimoBloque = -1;
+            posicion = (int)d.terminos.size();
+            d.terminos.push_back(t);
+            d.posiciones[t.termino] = posicion;
+            d.cabecera.cantidadTerminos++;
+        } else {
+            posicion = encontrado->second;
+        }
+
+        TerminoInvertido& t = d.terminos[posicion];
+        if (t.primerBloque != -1 && id <= t.ultimoID) continue;
+        int largo = codificarVarint((unsigned int)(id - t.ultimoID), varint);
+
+        if (t.primerBloque != -1 && t.usadosUltimo + largo <= t.capacidadUltimo) {
+            // Cabe en el ultimo bloque
+            long long destino = t.ultimoBloque + sizeof(CabeceraBloquePostings) + t.usadosUltimo;
+            postings.seekp(destino);
+            METRICA_POSICIONAMIENTO();
+            postings.write((char*)varint, largo);
+            t.usadosUltimo += largo;
+            postings.seekp(t.ultimoBloque + offsetof(CabeceraBloquePostings, usados));
+            METRICA_POSICIONAMIENTO();
+            postings.write((char*)&t.usadosUltimo, sizeof(int));
+            METRICA_ESCRITURA(largo + sizeof(int));
+        } else {
+            // Bloque nuevo con el doble de capacidad, enlazado al anterior
+            CabeceraBloquePostings bloque;
+            bloque.siguiente = -1;
+            bloque.capacidad = t.primerBloque == -1 ? BLOQUE_POSTINGS_MINIMO
+                             : min(BLOQUE_POSTINGS_MAXIMO, max(BLOQUE_POSTINGS_MINIMO, t.capacidadUltimo * 2));
+            bloque.usados = largo;
+            vector<unsigned char> datos(bloque.capacidad, 0);
+            memcpy(datos.data(), varint, largo);
+
+            postings.seekp(finPostings);
+            METRICA_POSICIONAMIENTO();
+            postings.write((char*)&bloque, sizeof(CabeceraBloquePostings));
+            postings.write((char*)datos.data(), datos.size());
+            METRICA_ESCRITURA(sizeof(CabeceraBloquePostings) + datos.size());
+
+            if (t.primerBloque == -1) {
+                t.primerBloque = finPostings;
+            } else {
+                postings.seekp(t.ultimoBloque + offsetof(CabeceraBloquePostings, siguiente));
+                METRICA_POSICIONAMIENTO();
+                postings.write((char*)&finPostings, sizeof(long long));
+                METRICA_ESCRITURA(sizeof(long long));
+            }
+            t.ultimoBloque = finPostings;
+            t.capacidadUltimo = bloque.capacidad;
+            t.usadosUltimo = largo;
+            finPostings += sizeof(CabeceraBloquePostings) + bloque.capacidad;
+        }
+
+        t.ultimoID = id;
+        t.cantidad++;
+        terminos.seekp(posicionTerminoInvertido(posicion));
+        METRICA_POSICIONAMIENTO();
+        terminos.write((char*)&t, sizeof(TerminoInvertido));
+        METRICA_ESCRITURA(sizeof(TerminoInvertido));
+    }
+    postings.close();
+
+    // La cabecera va al final: si algo falla antes, el indice queda desactualizado
+    // (registrosCubiertos no coincide) y se reconstruye al iniciar
+    d.cabecera.registrosCubiertos = registrosCubiertos;
+    d.cabecera.cantidadDocumentos++;
+    terminos.seekp(0);
+    METRICA_POSICIONAMIENTO();
+    terminos.write((char*)&d.cabecera, sizeof(CabeceraIndiceInvertido));
+    METRICA_ESCRITURA(sizeof(CabeceraIndiceInvertido));
+    terminos.close();
+
+    if (!terminos || !postings) {
+        d.cargado = false;
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// CONSULTAS
+// ============================================================================
+
+// FUNCION: Leer la lista de IDs de un termino (sin candado)
+bool leerPostingsTermino(ifstream& postings, const TerminoInvertido& t, vector<int>& ids) {
+    ids.clear();
+    ids.reserve(t.cantidad);
+    int ultimoID = 0;
+    vector<unsigned char> datos;
+
+    for (long long bloque = t.primerBloque; bloque != -1; ) {
+        CabeceraBloquePostings cabecera;
+        postings.seekg(bloque);
+        METRICA_POSICIONAMIENTO();
+        postings.read((char*)&cabecera, sizeof(CabeceraBloquePostings));
+        datos.resize(cabecera.usados);
+        postings.read((char*)datos.data(), cabecera.usados);
+        METRICA_LECTURA(sizeof(CabeceraBloquePostings) + cabecera.usados);
+        if (!postings) {
+            return false;
+        }
+        decodificarPostings(datos.data(), cabecera.usados, ultimoID, ids);
+        bloque = cabecera.siguiente;
+    }
+    return true;
+}
+
+// FUNCION: Documentos que contienen todos (todos = true) o alguno de los terminos.
+// Termino a la vez: la interseccion empieza por la lista mas corta.
+bool consultarIndiceInvertido(const char* archivoTerminos, const char* archivoPostings,
+                              const vector<string>& terminosConsulta, bool todos, vector<int>& resultado) {
+    lock_guard<mutex> guardia(candadoIndiceInvertido);
+    resultado.clear();
+
+    DiccionarioInvertido& d = diccionarioInvertido(archivoTerminos);
+    if (!refrescarDiccionarioInvertido(archivoTerminos, d)) {
+        return false;
+    }
+
+    vector<const TerminoInvertido*> terminos;
+    for (const string& termino : terminosConsulta) {
+        auto encontrado = d.posiciones.find(termino.substr(0, LARGO_TERMINO - 1));
+        if (encontrado != d.posiciones.end()) {
+            terminos.push_back(&d.terminos[encontrado->second]);
+        } else if (todos) {
+            return true;            // Un termino ausente vacia la interseccion
+        }
+    }
+    if (terminos.empty()) {
+        return true;
+    }
+    sort(terminos.begin(), terminos.end(),
+         [](const TerminoInvertido* a, const TerminoInvertido* b) { return a->cantidad < b->cantidad; });
+
+    ifstream postings(archivoPostings, ios::binary);
+    METRICA_APERTURA();
+    if (!postings.is_open() || !leerPostingsTermino(postings, *terminos[0], resultado)) {
+        return false;
+    }
+
+    vector<int> lista, combinada;
+    for (size_t i = 1; i < terminos.size(); i++) {
+        if (todos && resultado.empty()) break;
+        if (!leerPostingsTermino(postings, *terminos[i], lista)) {
+            return false;
+        }
+        combinada.clear();
+        if (todos) {
+            set_intersection(resultado.begin(), resultado.end(), lista.begin(), lista.end(), back_inserter(combinada));
+        } else {
+            set_union(resultado.begin(), resultado.end(), lista.begin(), lista.end(), back_inserter(combinada));
+        }
+        resultado.swap(combinada);
+    }
+    return true;
+}
+
+#endif //INDICE_INVERTIDO_H
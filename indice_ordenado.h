@@ -0,0 +1,424 @@
+#ifndef INDICE_ORDENADO_H
+#define INDICE_ORDENADO_H
+
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <algorithm>
+#include "metricas.h"
+
+using namespace std;
+
+// ============================================================================
+// INDICE ORDENADO PERSISTENTE
+// ============================================================================
+// Indice secundario de claves fijas comparables con memcmp. El archivo tiene:
+//
+//   [CabeceraIndice][directorio][base ordenada][delta]
+//
+// - base: entradas ordenadas por (clave, id), agrupadas en paginas de 4 KB.
+// - directorio: primera clave de cada pagina; se mantiene en memoria, asi
+//   una busqueda lee solo las paginas que cubren el rango (una lectura por
+//   pagina) en vez de recorrer el archivo de datos.
+// - delta: altas y bajas recientes agregadas al final sin ordenar. Una baja
+//   es una entrada con borrada = 1. Gana la ultima entrada de cada (clave, id).
+//   Al superar LIMITE_DELTA_INDICE entradas se fusiona todo en una base nueva.
+//
+// Cada entrada guarda el id y la posicion (indice) del registro en el
+// archivo de datos, para leerlo con un solo acceso aleatorio. La cabecera
+// guarda la firma del header del archivo de datos indexado: quien verifica
+// el indice lo reconstruye si no coincide.
+
+const int VERSION_INDICE = 2;
+const int TAMANO_PAGINA_INDICE = 4096;
+const int LIMITE_DELTA_INDICE = 1024;
+
+struct CabeceraIndice {
+    int version;
+    int largoClave;
+    int cantidadBase;           // Entradas ordenadas
+    int cantidadDelta;          // Entradas agregadas al final
+    int entradasPorPagina;
+    int cantidadPaginas;
+    int registrosCubiertos;     // cantidadRegistros del archivo de datos indexado
+    int generacion;             // Cambia cada vez que se reescribe la base
+    unsigned long long firmaDatos;  // firma del header del archivo de datos indexado
+};
+
+template<int LARGO_CLAVE>
+struct EntradaIndice {
+    char clave[LARGO_CLAVE];
+    int id;
+    int indice;                 // Posicion del registro en el archivo de datos
+    int borrada;
+};
+
+template<int LARGO_CLAVE>
+bool menorEntrada(const EntradaIndice<LARGO_CLAVE>& a, const EntradaIndice<LARGO_CLAVE>& b) {
+    int comparacion = memcmp(a.clave, b.clave, LARGO_CLAVE);
+    return comparacion != 0 ? comparacion < 0 : a.id < b.id;
+}
+
+template<int LARGO_CLAVE>
+bool mismaEntrada(const EntradaIndice<LARGO_CLAVE>& a, const EntradaIndice<LARGO_CLAVE>& b) {
+    return a.id == b.id && memcmp(a.clave, b.clave, LARGO_CLAVE) == 0;
+}
+
+// Rango [desde, hasta] (inclusivo) de todas las claves que empiezan con prefijo
+void rangoPrefijo(const char* prefijo, int largoPrefijo, char* desde, char* hasta, int largoClave) {
+    if (largoPrefijo > largoClave) largoPrefijo = largoClave;
+    memset(desde, 0x00, largoClave);
+    memset(hasta, 0xFF, largoClave);
+    memcpy(desde, prefijo, largoPrefijo);
+    memcpy(hasta, prefijo, largoPrefijo);
+}
+
+// ============================================================================
+// CACHE EN MEMORIA (directorio y delta)
+// ============================================================================
+
+template<int LARGO_CLAVE>
+struct CacheIndice {
+    bool cargada;
+    CabeceraIndice cabecera;
+    vector<char> directorio;
+    vector<EntradaIndice<LARGO_CLAVE>> delta;
+};
+
+// Un solo candado para todos los indices: las operaciones son cortas
+mutex candadoIndices;
+
+template<int LARGO_CLAVE>
+CacheIndice<LARGO_CLAVE>& cacheIndice(const char* archivo) {
+    static map<string, CacheIndice<LARGO_CLAVE>> caches;
+    CacheIndice<LARGO_CLAVE>& cache = caches[archivo];
+    return cache;
+}
+
+template<int LARGO_CLAVE>
+long posicionBaseIndice(const CabeceraIndice& c) {
+    return sizeof(CabeceraIndice) + (long)c.cantidadPaginas * LARGO_CLAVE;
+}
+
+template<int LARGO_CLAVE>
+long posicionDeltaIndice(const CabeceraIndice& c) {
+    return posicionBaseIndice<LARGO_CLAVE>(c) + (long)c.cantidadBase * sizeof(EntradaIndice<LARGO_CLAVE>);
+}
+
+// FUNCION: Leer la cabecera de un indice (false si no existe o no es compatible)
+bool leerCabeceraIndice(const char* archivo, CabeceraIndice& cabecera, int largoClave) {
+    ifstream entrada(archivo, ios::binary);
+    METRICA_APERTURA();
+    if (!entrada.is_open()) {
+        return false;
+    }
+    entrada.read((char*)&cabecera, sizeof(CabeceraIndice));
+    METRICA_LECTURA(sizeof(CabeceraIndice));
+    return entrada.gcount() == sizeof(CabeceraIndice) &&
+           cabecera.version == VERSION_INDICE && cabecera.largoClave == largoClave;
+}
+
+// FUNCION: Poner al dia la cache con el archivo (sin candado)
+template<int LARGO_CLAVE>
+bool refrescarCacheIndice(const char* archivo, CacheIndice<LARGO_CLAVE>& cache) {
+    typedef EntradaIndice<LARGO_CLAVE> Entrada;
+
+    CabeceraIndice cabecera;
+    if (!leerCabeceraIndice(archivo, cabecera, LARGO_CLAVE)) {
+        cache.cargada = false;
+        return false;
+    }
+
+    bool recargar = !cache.cargada || cabecera.generacion != cache.cabecera.generacion ||
+                    cabecera.cantidadBase != cache.cabecera.cantidadBase ||
+                    cabecera.cantidadDelta < (int)cache.delta.size();
+    if (!recargar && cabecera.cantidadDelta == (int)cache.delta.size()) {
+        cache.cabecera = cabecera;
+        return true;
+    }
+
+    ifstream entrada(archivo, ios::binary);
+    METRICA_APERTURA();
+    if (!entrada.is_open()) {
+        cache.cargada = false;
+        return false;
+    }
+
+    if (recargar) {
+        cache.directorio.resize((size_t)cabecera.cantidadPaginas * LARGO_CLAVE);
+        entrada.seekg(sizeof(CabeceraIndice));
+        METRICA_POSICIONAMIENTO();
+        entrada.read(cache.directorio.data(), cache.directorio.size());
+        METRICA_LECTURA(cache.directorio.size());
+        cache.delta.clear();
+    }
+
+    // Solo se leen las entradas del delta que aun no estan en memoria
+    size_t yaLeidas = cache.delta.size();
+    cache.delta.resize(cabecera.cantidadDelta);
+    entrada.seekg(posicionDeltaIndice<LARGO_CLAVE>(cabecera) + (long)yaLeidas * sizeof(Entrada));
+    METRICA_POSICIONAMIENTO();
+    entrada.read((char*)(cache.delta.data() + yaLeidas), (cabecera.cantidadDelta - yaLeidas) * sizeof(Entrada));
+    METRICA_LECTURA((cabecera.cantidadDelta - yaLeidas) * sizeof(Entrada));
+
+    if (!entrada) {
+        cache.cargada = false;
+        return false;
+    }
+    cache.cabecera = cabecera;
+    cache.cargada = true;
+    return true;
+}
+
+// ============================================================================
+// CONSTRUCCION Y MANTENIMIENTO
+// ============================================================================
+
+// FUNCION: Escribir un indice completo a partir de sus entradas vivas (sin candado).
+// Se escribe en un temporal y se renombra, para no dejar un indice a medias.
+template<int LARGO_CLAVE>
+bool escribirIndiceOrdenado(const char* archivo, vector<EntradaIndice<LARGO_CLAVE>>& entradas,
+                            int registrosCubiertos, unsigned long long firmaDatos) {
+    typedef EntradaIndice<LARGO_CLAVE> Entrada;
+
+    sort(entradas.begin(), entradas.end(), menorEntrada<LARGO_CLAVE>);
+
+    CabeceraIndice anterior;
+    CabeceraIndice cabecera;
+    cabecera.version = VERSION_INDICE;
+    cabecera.largoClave = LARGO_CLAVE;
+    cabecera.cantidadBase = (int)entradas.size();
+    cabecera.cantidadDelta = 0;
+    cabecera.entradasPorPagina = TAMANO_PAGINA_INDICE / sizeof(Entrada);
+    cabecera.cantidadPaginas = (cabecera.cantidadBase + cabecera.entradasPorPagina - 1) / cabecera.entradasPorPagina;
+    cabecera.registrosCubiertos = registrosCubiertos;
+    cabecera.generacion = leerCabeceraIndice(archivo, anterior, LARGO_CLAVE) ? anterior.generacion + 1 : 1;
+    cabecera.firmaDatos = firmaDatos;
+
+    vector<char> directorio((size_t)cabecera.cantidadPaginas * LARGO_CLAVE);
+    for (int p = 0; p < cabecera.cantidadPaginas; p++) {
+        memcpy(&directorio[(size_t)p * LARGO_CLAVE], entradas[(size_t)p * cabecera.entradasPorPagina].clave, LARGO_CLAVE);
+    }
+
+    string temporal = string(archivo) + ".tmp";
+    ofstream salida(temporal.c_str(), ios::binary);
+    METRICA_APERTURA();
+    if (!salida.is_open()) {
+        return false;
+    }
+    salida.write((char*)&cabecera, sizeof(CabeceraIndice));
+    salida.write(directorio.data(), directorio.size());
+    salida.write((char*)entradas.data(), entradas.size() * sizeof(Entrada));
+    METRICA_ESCRITURA(sizeof(CabeceraIndice) + directorio.size() + entradas.size() * sizeof(Entrada));
+    salida.close();
+    if (!salida) {
+        remove(temporal.c_str());
+        return false;
+    }
+
+    remove(archivo);
+    if (rename(temporal.c_str(), archivo) != 0) {
+        return false;
+    }
+
+    cacheIndice<LARGO_CLAVE>(archivo).cargada = false;
+    return true;
+}
+
+// FUNCION: Construir un indice desde cero (reemplaza el existente)
+template<int LARGO_CLAVE>
+bool crearIndiceOrdenado(const char* archivo, vector<EntradaIndice<LARGO_CLAVE>>& entradas,
+                         int registrosCubiertos, unsigned long long firmaDatos) {
+    lock_guard<mutex> guardia(candadoIndices);
+    return escribirIndiceOrdenado<LARGO_CLAVE>(archivo, entradas, registrosCubiertos, firmaDatos);
+}
+
+// FUNCION: Aplicar el delta sobre un conjunto ordenado de entradas de la base.
+// Las entradas del delta que caen en [desde, hasta] reemplazan a las de la base.
+template<int LARGO_CLAVE>
+void aplicarDeltaIndice(vector<EntradaIndice<LARGO_CLAVE>>& base,
+                        const vector<EntradaIndice<LARGO_CLAVE>>& delta,
+                        const char* desde, const char* hasta) {
+    typedef EntradaIndice<LARGO_CLAVE> Entrada;
+
+    // La ultima entrada de cada (clave, id) es la que vale
+    vector<Entrada> recientes;
+    for (const Entrada& e : delta) {
+        if (memcmp(e.clave, desde, LARGO_CLAVE) >= 0 && memcmp(e.clave, hasta, LARGO_CLAVE) <= 0) {
+            recientes.push_back(e);
+        }
+    }
+    if (recientes.empty()) return;
+    stable_sort(recientes.begin(), recientes.end(), menorEntrada<LARGO_CLAVE>);
+
+    vector<Entrada> unidas;
+    unidas.reserve(base.size() + recientes.size());
+    size_t b = 0;
+    for (size_t r = 0; r < recientes.size(); r++) {
+        if (r + 1 < recientes.size() && mismaEntrada(recientes[r], recientes[r + 1])) continue;
+        while (b < base.size() && menorEntrada(base[b], recientes[r])) unidas.push_back(base[b++]);
+        if (b < base.size() && mismaEntrada(base[b], recientes[r])) b++;
+        if (!recientes[r].borrada) unidas.push_back(recientes[r]);
+    }
+    while (b < base.size()) unidas.push_back(base[b++]);
+    base.swap(unidas);
+}
+
+// FUNCION: Fusionar delta y base en una base nueva (sin candado)
+template<int LARGO_CLAVE>
+bool fusionarIndiceOrdenado(const char* archivo, CacheIndice<LARGO_CLAVE>& cache) {
+    typedef EntradaIndice<LARGO_CLAVE> Entrada;
+
+    ifstream entrada(archivo, ios::binary);
+    METRICA_APERTURA();
+    if (!entrada.is_open()) {
+        return false;
+    }
+    vector<Entrada> base(cache.cabecera.cantidadBase);
+    entrada.seekg(posicionBaseIndice<LARGO_CLAVE>(cache.cabecera));
+    METRICA_POSICIONAMIENTO();
+    entrada.read((char*)base.data(), base.size() * sizeof(Entrada));
+    METRICA_LECTURA(base.size() * sizeof(Entrada));
+    entrada.close();
+
+    char desde[LARGO_CLAVE], hasta[LARGO_CLAVE];
+    rangoPrefijo("", 0, desde, hasta, LARGO_CLAVE);
+    aplicarDeltaIndice<LARGO_CLAVE>(base, cache.delta, desde, hasta);
+    return escribirIndiceOrdenado<LARGO_CLAVE>(archivo, base, cache.cabecera.registrosCubiertos,
+                                               cache.cabecera.firmaDatos);
+}
+
+// FUNCION: Agregar entradas (altas o bajas) al delta del indice.
+// registrosCubiertos < 0 conserva el valor actual.
+template<int LARGO_CLAVE>
+bool agregarAIndice(const char* archivo, const EntradaIndice<LARGO_CLAVE>* entradas, int cantidad,
+                    int registrosCubiertos) {
+    typedef EntradaIndice<LARGO_CLAVE> Entrada;
+    lock_guard<mutex> guardia(candadoIndices);
+
+    CacheIndice<LARGO_CLAVE>& cache = cacheIndice<LARGO_CLAVE>(archivo);
+    if (!refrescarCacheIndice<LARGO_CLAVE>(archivo, cache)) {
+        return false;
+    }
+
+    fstream salida(archivo, ios::binary | ios::in | ios::out);
+    METRICA_APERTURA();
+    if (!salida.is_open()) {
+        return false;
+    }
+
+    CabeceraIndice& cabecera = cache.cabecera;
+    salida.seekp(posicionDeltaIndice<LARGO_CLAVE>(cabecera) + (long)cabecera.cantidadDelta * sizeof(Entrada));
+    METRICA_POSICIONAMIENTO();
+    salida.write((const char*)entradas, cantidad * sizeof(Entrada));
+    METRICA_ESCRITURA(cantidad * sizeof(Entrada));
+
+    cabecera.cantidadDelta += cantidad;
+    if (registrosCubiertos >= 0) cabecera.registrosCubiertos = registrosCubiertos;
+    salida.seekp(0);
+    METRICA_POSICIONAMIENTO();
+    salida.write((char*)&cabecera, sizeof(CabeceraIndice));
+    METRICA_ESCRITURA(sizeof(CabeceraIndice));
+    salida.close();
+    if (!salida) {
+        cache.cargada = false;
+        return false;
+    }
+    cache.delta.insert(cache.delta.end(), entradas, entradas + cantidad);
+
+    if (cabecera.cantidadDelta >= LIMITE_DELTA_INDICE) {
+        return fusionarIndiceOrdenado<LARGO_CLAVE>(archivo, cache);
+    }
+    return true;
+}
+
+// ============================================================================
+// CONSULTAS
+// ============================================================================
+
+// FUNCION: Entradas vivas con desde <= clave <= hasta, en orden de clave.
+// limite < 0 devuelve todas. Lee solo las paginas de la base que cubren el rango.
+template<int LARGO_CLAVE>
+bool buscarRangoIndice(const char* archivo, const char* desde, const char* hasta,
+                       vector<EntradaIndice<LARGO_CLAVE>>& resultado, int limite) {
+    typedef EntradaIndice<LARGO_CLAVE> Entrada;
+    lock_guard<mutex> guardia(candadoIndices);
+    resultado.clear();
+
+    CacheIndice<LARGO_CLAVE>& cache = cacheIndice<LARGO_CLAVE>(archivo);
+    if (!refrescarCacheIndice<LARGO_CLAVE>(archivo, cache)) {
+        return false;
+    }
+    const CabeceraIndice& cabecera = cache.cabecera;
+
+    // Con limite hay que leer de mas por las bajas del delta que caigan en el rango
+    long necesarias = -1;
+    if (limite >= 0) {
+        necesarias = limite;
+        for (const Entrada& e : cache.delta) {
+            if (memcmp(e.clave, desde, LARGO_CLAVE) >= 0 && memcmp(e.clave, hasta, LARGO_CLAVE) <= 0) necesarias++;
+        }
+    }
+
+    // Ultima pagina cuya primera clave es < desde (las claves repetidas pueden
+    // empezar en la pagina anterior a la que las tiene como primera)
+    int bajo = 0, alto = cabecera.cantidadPaginas;
+    while (bajo < alto) {
+        int medio = (bajo + alto) / 2;
+        if (memcmp(&cache.directorio[(size_t)medio * LARGO_CLAVE], desde, LARGO_CLAVE) < 0) bajo = medio + 1;
+        else alto = medio;
+    }
+    int pagina = bajo > 0 ? bajo - 1 : 0;
+
+    ifstream entrada(archivo, ios::binary);
+    METRICA_APERTURA();
+    if (!entrada.is_open()) {
+        return false;
+    }
+
+    vector<Entrada> buffer(cabecera.entradasPorPagina);
+    bool terminado = false;
+    for (; pagina < cabecera.cantidadPaginas && !terminado; pagina++) {
+        long primera = (long)pagina * cabecera.entradasPorPagina;
+        int cantidad = (int)min<long>(cabecera.entradasPorPagina, cabecera.cantidadBase - primera);
+        entrada.seekg(posicionBaseIndice<LARGO_CLAVE>(cabecera) + primera * sizeof(Entrada));
+        METRICA_POSICIONAMIENTO();
+        entrada.read((char*)buffer.data(), cantidad * sizeof(Entrada));
+        METRICA_LECTURA(cantidad * sizeof(Entrada));
+
+        for (int i = 0; i < cantidad; i++) {
+            if (memcmp(buffer[i].clave, hasta, LARGO_CLAVE) > 0) {
+                terminado = true;
+                break;
+            }
+            if (memcmp(buffer[i].clave, desde, LARGO_CLAVE) >= 0) {
+                resultado.push_back(buffer[i]);
+                if (necesarias >= 0 && (long)resultado.size() >= necesarias) {
+                    terminado = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    aplicarDeltaIndice<LARGO_CLAVE>(resultado, cache.delta, desde, hasta);
+    if (limite >= 0 && (int)resultado.size() > limite) {
+        resultado.resize(limite);
+    }
+    return true;
+}
+
+// FUNCION: Entradas vivas cuya clave empieza con el prefijo dado
+template<int LARGO_CLAVE>
+bool buscarPrefijoIndice(const char* archivo, const char* prefijo, int largoPrefijo,
+                         vector<EntradaIndice<LARGO_CLAVE>>& resultado, int limite) {
+    char desde[LARGO_CLAVE], hasta[LARGO_CLAVE];
+    rangoPrefijo(prefijo, largoPrefijo, desde, hasta, LARGO_CLAVE);
+    return buscarRangoIndice<LARGO_CLAVE>(archivo, desde, hasta, resultado, limite);
+}
+
+#endif //INDICE_ORDENADO_H
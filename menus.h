@@ -2,7 +2,7 @@
 #define MENUS_H
 
 #include <iostream>
-#include "FUNCIONES.h"
+#include "funciones.H"
 
 using namespace std;
 
@@ -12,6 +12,49 @@ using namespace std;
 // SISTEMA DE MENS
 // ============================================================================
 
+//  FUNCIN: Mostrar una lista de pacientes encontrados
+void mostrarPacientesEncontrados(const vector<Paciente>& pacientes) {
+    if (pacientes.empty()) {
+        mostrarError("No se encontraron pacientes");
+        return;
+    }
+    
+    cout << "\n+------------------------------------------------------------+" << endl;
+    cout << " ID   APELLIDO, NOMBRE     CDULA        EDAD  CONSULTAS" << endl;
+    cout << "-----+---------------------+--------------+------+----------" << endl;
+    for (const Paciente& p : pacientes) {
+        cout << " " << setw(3) << p.id << "  "
+             << setw(19) << left << (string(p.apellido) + ", " + p.nombre).substr(0, 19) << "  "
+             << setw(12) << p.cedula << "  " << right
+             << setw(4) << p.edad << "  "
+             << setw(8) << p.cantidadConsultas << "" << endl;
+    }
+    cout << "+------------------------------------------------------------+" << endl;
+    cout << "Pacientes encontrados: " << pacientes.size() << endl;
+}
+
+//  FUNCIN: Mostrar una lista de citas encontradas
+void mostrarCitasEncontradas(const vector<Cita>& citas) {
+    if (citas.empty()) {
+        mostrarError("No se encontraron citas");
+        return;
+    }
+    
+    cout << "\n+--------------------------------------------------------------------+" << endl;
+    cout << " CITA    FECHA       HORA   PACIEN  DOCTOR  MOTIVO                 " << endl;
+    cout << "--------+------------+-------+--------+--------+------------------------" << endl;
+    for (const Cita& c : citas) {
+        cout << " " << setw(6) << right << c.id << "  "
+             << setw(10) << left << textoFecha(c.fecha) << "  "
+             << setw(5) << textoHora(c.hora) << "  "
+             << setw(6) << right << c.pacienteID << "  "
+             << setw(6) << c.doctorID << "  "
+             << setw(22) << left << string(c.motivo).substr(0, 22) << " " << right << endl;
+    }
+    cout << "+--------------------------------------------------------------------+" << endl;
+    cout << "Citas encontradas: " << citas.size() << endl;
+}
+
 //  FUNCIN: Men de gestin de pacientes
 void menuPacientes() {
     int opcion;
@@ -25,6 +68,11 @@ void menuPacientes() {
         cout << " 4. Ver historial medico               " << endl;
         cout << " 5. Ver citas del paciente             " << endl;
         cout << " 6. Listar todos los pacientes         " << endl;
+        cout << " 7. Buscar por apellido                " << endl;
+        cout << " 8. Listar por rango de apellidos      " << endl;
+        cout << " 9. Buscar en alergias u observaciones " << endl;
+        cout << "10. Buscar por sangre, sexo y edad     " << endl;
+        cout << "11. Eliminar paciente                  " << endl;
         cout << " 0. Volver al menu principal           " << endl;
         cout << "+----------------------------------------+" << endl;
         cout << "Opcion: ";
@@ -33,6 +81,7 @@ void menuPacientes() {
         
         switch (opcion) {
             case 1: {
+                TRAZA_ACCION("registrar paciente");
                 Paciente nuevo = crearPacienteInteractivo();
                 if (agregarPaciente(nuevo)) {
                     mostrarExito("Paciente creado exitosamente");
@@ -40,6 +89,7 @@ void menuPacientes() {
                 break;
             }
             case 2: {
+                TRAZA_ACCION("buscar paciente por cedula");
                 char cedula[20];
                 cout << "Cedula a buscar: ";
                 cin.getline(cedula, 20);
@@ -59,6 +109,7 @@ void menuPacientes() {
                 break;
             }
             case 3: {
+                TRAZA_ACCION("buscar paciente por id");
                 int id;
                 cout << "ID del paciente: ";
                 cin >> id;
@@ -71,7 +122,7 @@ void menuPacientes() {
                     cout << "   Cdula: " << paciente.cedula << endl;
                     cout << "   Edad: " << paciente.edad << endl;
                     cout << "   Sexo: " << paciente.sexo << endl;
-                    cout << "   Tipo sangre: " << paciente.tipoSangre << endl;
+                    cout << "   Tipo sangre: " << textoTipoSangre(paciente.tipoSangre) << endl;
                     cout << "   Telfono: " << paciente.telefono << endl;
                     cout << "   Email: " << paciente.email << endl;
                     cout << "   Alergias: " << paciente.alergias << endl;
@@ -84,6 +135,7 @@ void menuPacientes() {
                 break;
             }
             case 4: {
+                TRAZA_ACCION("ver historial medico");
                 int id;
                 cout << "ID del paciente: ";
                 cin >> id;
@@ -92,6 +144,7 @@ void menuPacientes() {
                 break;
             }
             case 5: {
+                TRAZA_ACCION("ver citas del paciente");
                 int id;
                 cout << "ID del paciente: ";
                 cin >> id;
@@ -99,9 +152,94 @@ void menuPacientes() {
                 listarCitasPaciente(id);
                 break;
             }
-            case 6:
-                listarPacientes();
+            case 6: {
+                TRAZA_ACCION("listar pacientes");
+                listarPacientes(FILAS_POR_PAGINA);
+                break;
+            }
+            case 7: {
+                TRAZA_ACCION("buscar paciente por apellido");
+                char apellido[50], nombre[50];
+                cout << "Apellido (o inicio del apellido): ";
+                cin.getline(apellido, 50);
+                cout << "Nombre (opcional, requiere apellido completo): ";
+                cin.getline(nombre, 50);
+                mostrarPacientesEncontrados(buscarPacientesPorApellido(apellido, nombre, 100));
+                break;
+            }
+            case 8: {
+                TRAZA_ACCION("listar pacientes por rango de apellidos");
+                char desde[50], hasta[50];
+                cout << "Desde apellido: ";
+                cin.getline(desde, 50);
+                cout << "Hasta apellido: ";
+                cin.getline(hasta, 50);
+                mostrarPacientesEncontrados(buscarPacientesPorRangoApellido(desde, hasta, 500));
+                break;
+            }
+            case 9: {
+                TRAZA_ACCION("buscar texto en pacientes");
+                char texto[100];
+                int campo;
+                cout << "1. Alergias  2. Observaciones: ";
+                cin >> campo;
+                limpiarBuffer();
+                cout << "Texto a buscar: ";
+                cin.getline(texto, 100);
+                CampoTexto donde = campo == 1 ? CAMPO_TEXTO(Paciente, alergias) : CAMPO_TEXTO(Paciente, observaciones);
+                mostrarPacientesEncontrados(buscarRegistrosConTexto<Paciente>(ARCHIVO_PACIENTES, donde, texto, true, 500));
+                break;
+            }
+            case 10: {
+                TRAZA_ACCION("buscar pacientes por sangre, sexo y edad");
+                FiltroMapasPacientes filtro = filtroMapasPacientes();
+                char tipos[60], sexo[5], activos[5];
+                cout << "Tipos de sangre separados por coma (ej. O-,O+; vacio = todos): ";
+                cin.getline(tipos, 60);
+                bool tiposValidos = true;
+                for (char* tipo = strtok(tipos, ", "); tipo != nullptr; tipo = strtok(nullptr, ", ")) {
+                    int codigo = codigoTipoSangre(tipo, strlen(tipo));
+                    tiposValidos = tiposValidos && codigo < CANTIDAD_TIPOS_SANGRE;
+                    filtro.sangre[codigo] = true;
+                }
+                if (!tiposValidos) {
+                    mostrarError("Tipo de sangre invalido");
+                    break;
+                }
+                cout << "Sexo (M/F, vacio = ambos): ";
+                cin.getline(sexo, 5);
+                if (sexo[0] != '\0') {
+                    filtro.sexo[codigoSexo((char)toupper((unsigned char)sexo[0]))] = true;
+                }
+                cout << "Edad desde: ";
+                cin >> filtro.edadDesde;
+                cout << "Edad hasta: ";
+                cin >> filtro.edadHasta;
+                limpiarBuffer();
+                cout << "Solo pacientes activos (s/n): ";
+                cin.getline(activos, 5);
+                if (activos[0] == 's' || activos[0] == 'S') {
+                    filtro.activo = 1;
+                }
+                
+                cout << "Pacientes que cumplen: " << contarPacientesPorMapas(filtro) << endl;
+                mostrarPacientesEncontrados(buscarPacientesPorMapas(filtro, 500));
+                break;
+            }
+            case 11: {
+                TRAZA_ACCION("eliminar paciente");
+                int id;
+                char confirmacion[5];
+                cout << "ID del paciente: ";
+                cin >> id;
+                limpiarBuffer();
+                cout << "Eliminar el paciente " << id << " (s/n): ";
+                cin.getline(confirmacion, 5);
+                if (confirmacion[0] == 's' || confirmacion[0] == 'S') {
+                    eliminarPaciente(id);
+                }
                 break;
+            }
             case 0:
                 cout << "Volviendo al menu principal..." << endl;
                 break;
@@ -121,6 +259,8 @@ void menuDoctores() {
         cout << " 1. Registrar nuevo doctor             " << endl;
         cout << " 2. Buscar doctor por ID               " << endl;
         cout << " 3. Listar todos los doctores          " << endl;
+        cout << " 4. Agenda del doctor                  " << endl;
+        cout << " 5. Doctores por especialidad          " << endl;
         cout << " 0. Volver al menu principal           " << endl;
         cout << "+----------------------------------------+" << endl;
         cout << "Opcion: ";
@@ -129,6 +269,7 @@ void menuDoctores() {
         
         switch (opcion) {
             case 1: {
+                TRAZA_ACCION("registrar doctor");
                 Doctor nuevo = crearDoctorInteractivo();
                 if (agregarDoctor(nuevo)) {
                     mostrarExito("Doctor creado exitosamente");
@@ -136,6 +277,7 @@ void menuDoctores() {
                 break;
             }
             case 2: {
+                TRAZA_ACCION("buscar doctor por id");
                 int id;
                 cout << "ID del doctor: ";
                 cin >> id;
@@ -145,7 +287,7 @@ void menuDoctores() {
                     cout << "* Doctor encontrado:" << endl;
                     cout << "   ID: " << doctor.id << endl;
                     cout << "   Nombre: " << doctor.nombre << " " << doctor.apellido << endl;
-                    cout << "   Especialidad: " << doctor.especialidad << endl;
+                    cout << "   Especialidad: " << textoEspecialidad(doctor.especialidad) << endl;
                     cout << "   Cdula: " << doctor.cedulaProfesional << endl;
                     cout << "   Aos experiencia: " << doctor.aniosExperiencia << endl;
                     cout << "   Costo consulta: $" << doctor.costoConsulta << endl;
@@ -160,9 +302,53 @@ void menuDoctores() {
                 }
                 break;
             }
-            case 3:
-                listarDoctores();
+            case 3: {
+                TRAZA_ACCION("listar doctores");
+                listarDoctores(FILAS_POR_PAGINA);
                 break;
+            }
+            case 4: {
+                TRAZA_ACCION("agenda del doctor");
+                int id, dias;
+                char desde[11];
+                cout << "ID del doctor: ";
+                cin >> id;
+                limpiarBuffer();
+                
+                cout << "Desde (YYYY-MM-DD, vacio = hoy): ";
+                cin.getline(desde, 11);
+                Fecha fechaDesde = desde[0] == '\0' ? fechaHoy() : parsearFecha(desde);
+                if (fechaDesde == FECHA_INVALIDA) {
+                    mostrarError("Fecha invalida");
+                    break;
+                }
+                
+                cout << "Cantidad de dias (1 = solo ese dia): ";
+                cin >> dias;
+                limpiarBuffer();
+                if (dias < 1) dias = 1;
+                
+                mostrarAgendaDoctor(id, fechaDesde, fechaDesde + dias - 1);
+                break;
+            }
+            case 5: {
+                TRAZA_ACCION("doctores por especialidad");
+                char especialidad[50];
+                char desde[11];
+                cout << "Especialidad: ";
+                cin.getline(especialidad, 50);
+                
+                cout << "Desde (YYYY-MM-DD, vacio = hoy): ";
+                cin.getline(desde, 11);
+                Fecha fechaDesde = desde[0] == '\0' ? fechaHoy() : parsearFecha(desde);
+                if (fechaDesde == FECHA_INVALIDA) {
+                    mostrarError("Fecha invalida");
+                    break;
+                }
+                
+                mostrarDoctoresPorEspecialidad(especialidad, fechaDesde);
+                break;
+            }
             case 0:
                 cout << "Volviendo al menu principal..." << endl;
                 break;
@@ -183,6 +369,9 @@ void menuCitas() {
         cout << " 2. Ver citas de paciente              " << endl;
         cout << " 3. Cancelar cita                      " << endl;
         cout << " 4. Verificar disponibilidad           " << endl;
+        cout << " 5. Buscar citas por motivo            " << endl;
+        cout << " 6. Agenda por fecha                   " << endl;
+        cout << " 7. Buscar turnos libres               " << endl;
         cout << " 0. Volver al menu principal           " << endl;
         cout << "+----------------------------------------+" << endl;
         cout << "Opcion: ";
@@ -191,6 +380,7 @@ void menuCitas() {
         
         switch (opcion) {
             case 1: {
+                TRAZA_ACCION("agendar cita");
                 Cita nueva = agendarCitaInteractivo();
                 if (nueva.id != -1 && agregarCita(nueva)) {
                     mostrarExito("Cita agendada exitosamente");
@@ -198,6 +388,7 @@ void menuCitas() {
                 break;
             }
             case 2: {
+                TRAZA_ACCION("ver citas del paciente");
                 int id;
                 cout << "ID del paciente: ";
                 cin >> id;
@@ -206,6 +397,7 @@ void menuCitas() {
                 break;
             }
             case 3: {
+                TRAZA_ACCION("cancelar cita");
                 int id;
                 cout << "ID de la cita a cancelar: ";
                 cin >> id;
@@ -214,18 +406,14 @@ void menuCitas() {
                 break;
             }
             case 4: {
+                TRAZA_ACCION("verificar disponibilidad");
                 int doctorID;
-                char fecha[11], hora[6];
-                
                 cout << "ID del doctor: ";
                 cin >> doctorID;
                 limpiarBuffer();
                 
-                cout << "Fecha (YYYY-MM-DD): ";
-                cin.getline(fecha, 11);
-                
-                cout << "Hora (HH:MM): ";
-                cin.getline(hora, 6);
+                Fecha fecha = leerFechaConsola("Fecha (YYYY-MM-DD): ");
+                Hora hora = leerHoraConsola("Hora (HH:MM): ");
                 
                 if (verificarDisponibilidad(doctorID, fecha, hora)) {
                     cout << "*El doctor esta disponible en ese horario." << endl;
@@ -234,6 +422,70 @@ void menuCitas() {
                 }
                 break;
             }
+            case 5: {
+                TRAZA_ACCION("buscar citas por motivo");
+                char texto[100];
+                cout << "Texto a buscar en el motivo: ";
+                cin.getline(texto, 100);
+                
+                mostrarCitasEncontradas(buscarRegistrosConTexto<Cita>(ARCHIVO_CITAS, CAMPO_TEXTO(Cita, motivo), texto, true, 200));
+                break;
+            }
+            case 6: {
+                TRAZA_ACCION("agenda por fecha");
+                char desde[11], hasta[11];
+                int doctorID;
+                
+                cout << "Desde (YYYY-MM-DD): ";
+                cin.getline(desde, 11);
+                cout << "Hasta (YYYY-MM-DD, vacio = mismo dia): ";
+                cin.getline(hasta, 11);
+                if (hasta[0] == '\0') strcpy(hasta, desde);
+                
+                Fecha fechaDesde = parsearFecha(desde);
+                Fecha fechaHasta = parsearFecha(hasta);
+                if (fechaDesde == FECHA_INVALIDA || fechaHasta == FECHA_INVALIDA) {
+                    mostrarError("Fecha invalida");
+                    break;
+                }
+                
+                cout << "ID del doctor (0 = todos): ";
+                cin >> doctorID;
+                limpiarBuffer();
+                
+                mostrarCitasEncontradas(buscarCitasPorFecha(fechaDesde, fechaHasta, doctorID, 500));
+                break;
+            }
+            case 7: {
+                TRAZA_ACCION("buscar turnos libres");
+                int doctorID, cantidad;
+                char especialidad[50] = "", desde[11];
+                
+                cout << "ID del doctor (0 = por especialidad): ";
+                cin >> doctorID;
+                limpiarBuffer();
+                if (doctorID <= 0) {
+                    cout << "Especialidad: ";
+                    cin.getline(especialidad, 50);
+                }
+                
+                cout << "Desde (YYYY-MM-DD, vacio = ahora): ";
+                cin.getline(desde, 11);
+                Fecha fechaDesde = desde[0] == '\0' ? fechaHoy() : parsearFecha(desde);
+                if (fechaDesde == FECHA_INVALIDA) {
+                    mostrarError("Fecha invalida");
+                    break;
+                }
+                
+                cout << "Cantidad de turnos: ";
+                cin >> cantidad;
+                limpiarBuffer();
+                if (cantidad < 1) cantidad = 1;
+                
+                Hora desdeHora = desde[0] == '\0' ? horaActual() : 0;
+                mostrarTurnosLibres(buscarTurnosLibres(doctorID, especialidad, fechaDesde, desdeHora, cantidad));
+                break;
+            }
             case 0:
                 cout << "Volviendo al menu principal..." << endl;
                 break;
@@ -252,6 +504,7 @@ void menuHistorial() {
         cout << "----------------------------------------" << endl;
         cout << " 1. Agregar consulta al historial      " << endl;
         cout << " 2. Ver historial de paciente          " << endl;
+        cout << " 3. Buscar consultas por texto         " << endl;
         cout << " 0. Volver al men principal           " << endl;
         cout << "+----------------------------------------+" << endl;
         cout << "Opcion: ";
@@ -260,6 +513,7 @@ void menuHistorial() {
         
         switch (opcion) {
             case 1: {
+                TRAZA_ACCION("agregar consulta");
                 HistorialMedico nueva = crearConsultaInteractivo();
                 if (nueva.id != -1 && agregarConsultaAlHistorial(nueva)) {
                     mostrarExito("Consulta agregada al historial");
@@ -267,6 +521,7 @@ void menuHistorial() {
                 break;
             }
             case 2: {
+                TRAZA_ACCION("ver historial medico");
                 int id;
                 cout << "ID del paciente: ";
                 cin >> id;
@@ -274,6 +529,40 @@ void menuHistorial() {
                 mostrarHistorialMedico(id);
                 break;
             }
+            case 3: {
+                TRAZA_ACCION("buscar consultas por texto");
+                char texto[200];
+                int modo;
+                cout << "Palabras a buscar (diagnostico, tratamiento, medicamentos): ";
+                cin.getline(texto, 200);
+                cout << "1. Todas las palabras  2. Cualquiera de ellas: ";
+                cin >> modo;
+                limpiarBuffer();
+                
+                vector<int> ids = buscarConsultasPorTexto(texto, modo != 2);
+                if (ids.empty()) {
+                    mostrarError("No se encontraron consultas");
+                    break;
+                }
+                
+                // Las ms recientes primero
+                reverse(ids.begin(), ids.end());
+                vector<HistorialMedico> consultas = leerConsultasPorID(ids, 50);
+                cout << "\n+------------------------------------------------------------------------------+" << endl;
+                cout << " CONSUL  FECHA       PACIEN  DIAGNSTICO               MEDICAMENTOS         " << endl;
+                cout << "--------+------------+--------+--------------------------+----------------------" << endl;
+                for (const HistorialMedico& c : consultas) {
+                    cout << " " << setw(6) << right << c.id << "  "
+                         << setw(10) << left << textoFecha(c.fecha) << "  "
+                         << setw(6) << right << c.pacienteID << "  "
+                         << setw(24) << left << string(c.diagnostico).substr(0, 24) << "  "
+                         << setw(20) << string(c.medicamentos).substr(0, 20) << " " << right << endl;
+                }
+                cout << "+------------------------------------------------------------------------------+" << endl;
+                cout << "Consultas encontradas: " << ids.size()
+                     << (ids.size() > consultas.size() ? " (se muestran las 50 mas recientes)" : "") << endl;
+                break;
+            }
             case 0:
                 cout << "Volviendo al menu principal..." << endl;
                 break;
@@ -294,6 +583,7 @@ void menuMantenimiento() {
         cout << " 2. Crear respaldo                     " << endl;
         cout << " 3. Restaurar respaldo                 " << endl;
         cout << " 4. Verificar archivos                 " << endl;
+        cout << " 5. Fragmentacion de archivos          " << endl;
         cout << " 0. Volver al menu principal           " << endl;
         cout << "+----------------------------------------+" << endl;
         cout << "Opcion: ";
@@ -301,23 +591,151 @@ void menuMantenimiento() {
         limpiarBuffer();
         
         switch (opcion) {
-            case 1:
+            case 1: {
+                TRAZA_ACCION("compactar archivos");
+                double fragmentacion = fragmentacionArchivo(ARCHIVO_PACIENTES);
+                cout << "Registros eliminados en " << ARCHIVO_PACIENTES << ": " << fixed << setprecision(1)
+                     << fragmentacion * 100 << "%" << endl;
+                if (fragmentacion < FRAGMENTACION_PARA_COMPACTAR) {
+                    char confirmacion[5];
+                    cout << "Por debajo del " << (int)(FRAGMENTACION_PARA_COMPACTAR * 100)
+                         << "% no suele compensar reescribir el archivo. Compactar igual (s/n): ";
+                    cin.getline(confirmacion, 5);
+                    if (confirmacion[0] != 's' && confirmacion[0] != 'S') {
+                        break;
+                    }
+                }
                 compactarArchivoPacientes();
                 break;
-            case 2:
+            }
+            case 2: {
+                TRAZA_ACCION("crear respaldo");
                 crearRespaldo();
                 break;
-            case 3:
+            }
+            case 3: {
+                TRAZA_ACCION("restaurar respaldo");
                 restaurarRespaldo();
                 break;
+            }
             case 4:
                 cout << "*Verificando archivos del sistema..." << endl;
-                verificarArchivo(ARCHIVO_HOSPITAL);
                 verificarArchivo(ARCHIVO_PACIENTES);
                 verificarArchivo(ARCHIVO_DOCTORES);
                 verificarArchivo(ARCHIVO_CITAS);
                 verificarArchivo(ARCHIVO_HISTORIALES);
                 break;
+            case 5:
+                mostrarFragmentacion();
+                break;
+            case 0:
+                cout << "Volviendo al menu principal..." << endl;
+                break;
+            default:
+                mostrarError("Opcion invalida");
+        }
+    } while (opcion != 0);
+}
+
+//  FUNCIN: Men de reportes y estadsticas
+void menuReportes() {
+    int opcion;
+    do {
+        cout << "\n+----------------------------------------+" << endl;
+        cout << "        REPORTES Y ESTADISTICAS        " << endl;
+        cout << "----------------------------------------" << endl;
+        cout << " 1. Estadisticas generales             " << endl;
+        cout << " 2. Metricas de rendimiento            " << endl;
+        cout << " 3. Exportar metricas (JSON)           " << endl;
+        cout << " 4. Exportar metricas (Prometheus)     " << endl;
+        cout << " 5. Reiniciar metricas                 " << endl;
+        cout << " 6. Activar/desactivar traza           " << endl;
+        cout << " 7. Exportar traza (Chrome/Perfetto)   " << endl;
+        cout << " 8. Reporte analitico                  " << endl;
+        cout << " 9. Tablero diario                     " << endl;
+        cout << " 10. Consulta ad-hoc                   " << endl;
+        cout << " 0. Volver al menu principal           " << endl;
+        cout << "+----------------------------------------+" << endl;
+        cout << "Opcion: ";
+        cin >> opcion;
+        limpiarBuffer();
+        
+        switch (opcion) {
+            case 1:
+                mostrarEstadisticas();
+                break;
+            case 2:
+                mostrarMetricas();
+                break;
+            case 3:
+                if (exportarMetricasJSON("metricas.json")) {
+                    mostrarExito("Metricas exportadas a metricas.json");
+                } else {
+                    mostrarError("No se pudo escribir metricas.json");
+                }
+                break;
+            case 4:
+                if (exportarMetricasPrometheus("metricas.prom")) {
+                    mostrarExito("Metricas exportadas a metricas.prom");
+                } else {
+                    mostrarError("No se pudo escribir metricas.prom");
+                }
+                break;
+            case 5:
+                reiniciarMetricas();
+                mostrarExito("Metricas reiniciadas");
+                break;
+            case 6:
+                activarTraza(!trazaActiva.load());
+                if (trazaActiva.load()) {
+                    mostrarExito("Traza activada");
+                } else {
+                    mostrarInfo("Traza desactivada");
+                }
+                break;
+            case 7:
+                if (exportarTrazaChrome("traza.json")) {
+                    cout << "* " << eventosEnTraza() << " eventos exportados a traza.json"
+                         << " (abrir en chrome://tracing o ui.perfetto.dev)" << endl;
+                } else {
+                    mostrarError("No se pudo escribir traza.json");
+                }
+                break;
+            case 8:
+                mostrarReporteAnalitico();
+                break;
+            case 9: {
+                int dias;
+                char hasta[11];
+                cout << "Hasta (YYYY-MM-DD, vacio = hoy): ";
+                cin.getline(hasta, 11);
+                Fecha fechaHasta = hasta[0] == '\0' ? fechaHoy() : parsearFecha(hasta);
+                if (fechaHasta == FECHA_INVALIDA) {
+                    mostrarError("Fecha invalida");
+                    break;
+                }
+                
+                cout << "Cantidad de dias hacia atras (1 = solo ese dia): ";
+                cin >> dias;
+                limpiarBuffer();
+                if (dias < 1) dias = 1;
+                
+                mostrarTableroDiario(fechaHasta - dias + 1, fechaHasta);
+                break;
+            }
+            case 10: {
+                char consulta[512];
+                cout << "Ejemplo: pacientes donde edad > 65 y tipoSangre = O- y ultimaConsulta < hoy-365" << endl;
+                cout << "Consulta: ";
+                cin.getline(consulta, sizeof(consulta));
+                if (!cin) {
+                    limpiarBuffer();
+                    mostrarError("Consulta demasiado larga");
+                    break;
+                }
+                ejecutarConsultaAdHoc(consulta, FILAS_POR_PAGINA);
+                break;
+            }
             case 0:
                 cout << "Volviendo al menu principal..." << endl;
                 break;
@@ -360,7 +778,7 @@ void menuPrincipal() {
                 menuHistorial();
                 break;
             case 5:
-                mostrarEstadisticas();
+                menuReportes();
                 break;
             case 6:
                 menuMantenimiento();
@@ -0,0 +1,573 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <functional>
+
+using namespace std;
+
+// ============================================================================
+// METRICAS DE RENDIMIENTO
+// ============================================================================
+// Cada funcion de almacenamiento cuenta llamadas, latencia (histograma
+// log-lineal estilo HDR), registros leidos, bytes leidos/escritos, aperturas
+// de archivo y posicionamientos (seek). Los contadores son por hilo y se
+// suman solo al consultarlos.
+//
+// Compilar con -DSIN_METRICAS elimina toda la instrumentacion.
+
+enum OperacionMetrica {
+    MET_LEER_HEADER,
+    MET_ACTUALIZAR_HEADER,
+    MET_CARGAR_HOSPITAL,
+    MET_GUARDAR_HOSPITAL,
+    MET_BUSCAR_INDICE_PACIENTE,
+    MET_LEER_PACIENTE_INDICE,
+    MET_BUSCAR_PACIENTE_ID,
+    MET_BUSCAR_PACIENTE_CEDULA,
+    MET_AGREGAR_PACIENTE,
+    MET_ACTUALIZAR_PACIENTE,
+    MET_ELIMINAR_PACIENTE,
+    MET_LISTAR_PACIENTES,
+    MET_BUSCAR_DOCTOR_ID,
+    MET_AGREGAR_DOCTOR,
+    MET_LISTAR_DOCTORES,
+    MET_BUSCAR_INDICE_CITA,
+    MET_AGREGAR_CITA,
+    MET_VERIFICAR_DISPONIBILIDAD,
+    MET_LISTAR_CITAS_PACIENTE,
+    MET_CANCELAR_CITA,
+    MET_AGREGAR_CONSULTA,
+    MET_MOSTRAR_HISTORIAL,
+    MET_COMPACTAR_PACIENTES,
+    MET_CREAR_RESPALDO,
+    MET_RESTAURAR_RESPALDO,
+    MET_BUSCAR_PACIENTES_APELLIDO,
+    MET_RECONSTRUIR_INDICE_APELLIDOS,
+    MET_BUSCAR_CONSULTAS_TEXTO,
+    MET_RECONSTRUIR_INDICE_TEXTO,
+    MET_BUSCAR_TEXTO_LIBRE,
+    MET_BUSCAR_CITAS_FECHA,
+    MET_RECONSTRUIR_INDICE_CITAS,
+    MET_RESOLVER_REGISTROS_ID,
+    MET_AGENDA_DOCTOR,
+    MET_REPORTE_ANALITICO,
+    MET_RECONSTRUIR_ESTADISTICAS,
+    MET_TABLERO_DIARIO,
+    MET_BUSCAR_TURNOS_LIBRES,
+    MET_RECONSTRUIR_INDICE_ESPECIALIDADES,
+    MET_DOCTOR_MENOS_CARGADO,
+    MET_CONSULTA_ADHOC,
+    MET_RECONSTRUIR_MAPAS_PACIENTES,
+    MET_BUSCAR_PACIENTES_MAPAS,
+    CANT_OPERACIONES_METRICA
+};
+
+const char* NOMBRES_METRICA[] = {
+    "leerHeader",
+    "actualizarHeader",
+    "cargarDatosHospital",
+    "guardarDatosHospital",
+    "buscarIndicePacientePorID",
+    "leerPacientePorIndice",
+    "buscarPacientePorID",
+    "buscarPacientePorCedula",
+    "agregarPaciente",
+    "actualizarPaciente",
+    "eliminarPaciente",
+    "listarPacientes",
+    "buscarDoctorPorID",
+    "agregarDoctor",
+    "listarDoctores",
+    "buscarIndiceCitaPorID",
+    "agregarCita",
+    "verificarDisponibilidad",
+    "listarCitasPaciente",
+    "cancelarCita",
+    "agregarConsultaAlHistorial",
+    "mostrarHistorialMedico",
+    "compactarArchivoPacientes",
+    "crearRespaldo",
+    "restaurarRespaldo",
+    "buscarPacientesPorApellido",
+    "reconstruirIndiceApellidos",
+    "buscarConsultasPorTexto",
+    "reconstruirIndiceTexto",
+    "buscarRegistrosConTexto",
+    "buscarCitasPorFecha",
+    "reconstruirIndiceCitas",
+    "resolverRegistrosPorID",
+    "mostrarAgendaDoctor",
+    "calcularReporteAnalitico",
+    "reconstruirEstadisticasDiarias",
+    "mostrarTableroDiario",
+    "buscarTurnosLibres",
+    "reconstruirIndiceEspecialidades",
+    "doctorMenosCargado",
+    "ejecutarConsultaAdHoc",
+    "reconstruirMapasPacientes",
+    "buscarPacientesPorMapas"
+};
+
+// ============================================================================
+// HISTOGRAMA LOG-LINEAL
+// ============================================================================
+// 16 sub-cubetas por potencia de 2 (error relativo < 7%), de 1 a 2^43 unidades.
+// Las metricas lo usan en nanosegundos.
+
+const int SUBCUBETAS_LATENCIA = 16;
+const int CANT_CUBETAS_LATENCIA = SUBCUBETAS_LATENCIA * 40;
+
+struct HistogramaLatencia {
+    long long cuentas[CANT_CUBETAS_LATENCIA];
+    long long total;
+    long long suma;
+    long long maximo;
+};
+
+void limpiarHistograma(HistogramaLatencia& h) {
+    memset(&h, 0, sizeof(HistogramaLatencia));
+}
+
+int cubetaLatencia(long long valor) {
+    if (valor < SUBCUBETAS_LATENCIA) return (int)(valor < 0 ? 0 : valor);
+    int exponente = 63 - __builtin_clzll((unsigned long long)valor);
+    int sub = (int)((valor >> (exponente - 4)) & (SUBCUBETAS_LATENCIA - 1));
+    int indice = (exponente - 3) * SUBCUBETAS_LATENCIA + sub;
+    return indice < CANT_CUBETAS_LATENCIA ? indice : CANT_CUBETAS_LATENCIA - 1;
+}
+
+// Limite superior (exclusivo) de una cubeta
+long long limiteCubetaLatencia(int indice) {
+    if (indice < SUBCUBETAS_LATENCIA) return indice + 1;
+    int exponente = indice / SUBCUBETAS_LATENCIA + 3;
+    int sub = indice % SUBCUBETAS_LATENCIA;
+    return (1LL << exponente) + ((long long)(sub + 1) << (exponente - 4));
+}
+
+void registrarEnHistograma(HistogramaLatencia& h, long long valor) {
+    h.cuentas[cubetaLatencia(valor)]++;
+    h.total++;
+    h.suma += valor;
+    if (valor > h.maximo) h.maximo = valor;
+}
+
+void combinarHistogramas(HistogramaLatencia& destino, const HistogramaLatencia& origen) {
+    for (int i = 0; i < CANT_CUBETAS_LATENCIA; i++) destino.cuentas[i] += origen.cuentas[i];
+    destino.total += origen.total;
+    destino.suma += origen.suma;
+    if (origen.maximo > destino.maximo) destino.maximo = origen.maximo;
+}
+
+long long percentilHistograma(const HistogramaLatencia& h, double p) {
+    if (h.total == 0) return 0;
+    long long objetivo = (long long)(p * h.total);
+    long long acumulado = 0;
+    for (int i = 0; i < CANT_CUBETAS_LATENCIA; i++) {
+        acumulado += h.cuentas[i];
+        if (acumulado > objetivo) {
+            long long limite = limiteCubetaLatencia(i);
+            return limite < h.maximo ? limite : h.maximo;
+        }
+    }
+    return h.maximo;
+}
+
+// ============================================================================
+// CONTADORES POR HILO
+// ============================================================================
+
+// Solo el hilo duenio escribe sus contadores; los atomicos "relajados"
+// permiten leerlos desde otro hilo sin costo extra (sin lock ni fence).
+inline void sumarRelajado(atomic<long long>& contador, long long valor) {
+    contador.store(contador.load(memory_order_relaxed) + valor, memory_order_relaxed);
+}
+
+struct ContadoresOperacion {
+    atomic<long long> llamadas;
+    atomic<long long> registrosLeidos;
+    atomic<long long> bytesLeidos;
+    atomic<long long> bytesEscritos;
+    atomic<long long> aperturas;
+    atomic<long long> posicionamientos;
+    atomic<long long> latencia[CANT_CUBETAS_LATENCIA];
+    atomic<long long> latenciaSuma;
+    atomic<long long> latenciaMaxima;
+};
+
+// Contadores de E/S acumulados del hilo; cada medicion toma la diferencia
+struct ContadoresIOHilo {
+    long long registrosLeidos;
+    long long bytesLeidos;
+    long long bytesEscritos;
+    long long aperturas;
+    long long posicionamientos;
+};
+
+struct MetricasHilo {
+    ContadoresOperacion operaciones[CANT_OPERACIONES_METRICA];
+    ContadoresIOHilo io;
+};
+
+// Registro global de hilos. Las metricas de un hilo se conservan despues de
+// que termina, para no perder sus cuentas.
+mutex candadoMetricas;
+vector<MetricasHilo*> metricasRegistradas;
+thread_local MetricasHilo* metricasHiloActual = nullptr;
+
+MetricasHilo& metricasDelHilo() {
+    if (metricasHiloActual == nullptr) {
+        MetricasHilo* nuevas = new MetricasHilo();
+        lock_guard<mutex> guardia(candadoMetricas);
+        metricasRegistradas.push_back(nuevas);
+        metricasHiloActual = nuevas;
+    }
+    return *metricasHiloActual;
+}
+
+// Medicion con alcance: cuenta desde la construccion hasta el fin del bloque.
+// Es inclusiva: la E/S de las funciones llamadas se suma tambien aqui.
+struct MedicionOperacion {
+    OperacionMetrica operacion;
+    chrono::steady_clock::time_point inicio;
+    ContadoresIOHilo ioInicial;
+
+    MedicionOperacion(OperacionMetrica op) {
+        operacion = op;
+        ioInicial = metricasDelHilo().io;
+        inicio = chrono::steady_clock::now();
+    }
+
+    ~MedicionOperacion() {
+        long long nanos = chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now() - inicio).count();
+        MetricasHilo& m = metricasDelHilo();
+        ContadoresOperacion& c = m.operaciones[operacion];
+
+        sumarRelajado(c.llamadas, 1);
+        sumarRelajado(c.registrosLeidos, m.io.registrosLeidos - ioInicial.registrosLeidos);
+        sumarRelajado(c.bytesLeidos, m.io.bytesLeidos - ioInicial.bytesLeidos);
+        sumarRelajado(c.bytesEscritos, m.io.bytesEscritos - ioInicial.bytesEscritos);
+        sumarRelajado(c.aperturas, m.io.aperturas - ioInicial.aperturas);
+        sumarRelajado(c.posicionamientos, m.io.posicionamientos - ioInicial.posicionamientos);
+        sumarRelajado(c.latencia[cubetaLatencia(nanos)], 1);
+        sumarRelajado(c.latenciaSuma, nanos);
+        if (nanos > c.latenciaMaxima.load(memory_order_relaxed)) {
+            c.latenciaMaxima.store(nanos, memory_order_relaxed);
+        }
+    }
+};
+
+#ifndef SIN_METRICAS
+#define MEDIR_OPERACION(op) MedicionOperacion medicionOperacion(op)
+#define METRICA_APERTURA() (metricasDelHilo().io.aperturas++)
+#define METRICA_POSICIONAMIENTO() (metricasDelHilo().io.posicionamientos++)
+#define METRICA_LECTURA(bytes) (metricasDelHilo().io.bytesLeidos += (bytes))
+#define METRICA_REGISTRO_LEIDO(bytes) (metricasDelHilo().io.registrosLeidos++, METRICA_LECTURA(bytes))
+#define METRICA_REGISTROS_LEIDOS(cantidad, bytes) (metricasDelHilo().io.registrosLeidos += (cantidad), METRICA_LECTURA(bytes))
+#define METRICA_ESCRITURA(bytes) (metricasDelHilo().io.bytesEscritos += (bytes))
+#else
+#define MEDIR_OPERACION(op) ((void)0)
+#define METRICA_APERTURA() ((void)0)
+#define METRICA_POSICIONAMIENTO() ((void)0)
+#define METRICA_LECTURA(bytes) ((void)0)
+#define METRICA_REGISTRO_LEIDO(bytes) ((void)0)
+#define METRICA_REGISTROS_LEIDOS(cantidad, bytes) ((void)0)
+#define METRICA_ESCRITURA(bytes) ((void)0)
+#endif
+
+// ============================================================================
+// CACHES
+// ============================================================================
+// Las caches de registros (cache_registros.h) se registran aqui para que sus
+// aciertos y fallos salgan junto con las metricas de las operaciones. Cada
+// cache lleva sus propios contadores; aqui solo se guarda como leerlos.
+
+struct ResumenCache {
+    string nombre;
+    long long aciertos;
+    long long fallos;
+    long long invalidaciones;
+    long long expulsiones;
+    long long entradas;
+    long long bytesUsados;
+    long long presupuesto;
+};
+
+struct FuenteCache {
+    function<ResumenCache()> leer;
+    function<void()> reiniciar;
+};
+
+vector<FuenteCache> cachesRegistradas;
+
+void registrarCacheMetricas(function<ResumenCache()> leer, function<void()> reiniciar) {
+    lock_guard<mutex> guardia(candadoMetricas);
+    cachesRegistradas.push_back({leer, reiniciar});
+}
+
+vector<FuenteCache> fuentesCache() {
+    lock_guard<mutex> guardia(candadoMetricas);
+    return cachesRegistradas;
+}
+
+vector<ResumenCache> leerCaches() {
+    vector<ResumenCache> resumen;
+    for (const FuenteCache& f : fuentesCache()) resumen.push_back(f.leer());
+    return resumen;
+}
+
+double tasaAciertosCache(const ResumenCache& c) {
+    long long consultas = c.aciertos + c.fallos;
+    return consultas > 0 ? 100.0 * c.aciertos / consultas : 0;
+}
+
+// ============================================================================
+// LECTURA, REINICIO Y EXPORTACION
+// ============================================================================
+
+struct ResumenOperacion {
+    long long llamadas;
+    long long registrosLeidos;
+    long long bytesLeidos;
+    long long bytesEscritos;
+    long long aperturas;
+    long long posicionamientos;
+    HistogramaLatencia latencia;     // Nanosegundos
+};
+
+// FUNCION: Sumar los contadores de todos los hilos
+vector<ResumenOperacion> leerMetricas() {
+    vector<ResumenOperacion> resumen(CANT_OPERACIONES_METRICA);
+    for (ResumenOperacion& r : resumen) {
+        r.llamadas = r.registrosLeidos = r.bytesLeidos = r.bytesEscritos = 0;
+        r.aperturas = r.posicionamientos = 0;
+        limpiarHistograma(r.latencia);
+    }
+
+    lock_guard<mutex> guardia(candadoMetricas);
+    for (MetricasHilo* m : metricasRegistradas) {
+        for (int op = 0; op < CANT_OPERACIONES_METRICA; op++) {
+            ContadoresOperacion& c = m->operaciones[op];
+            ResumenOperacion& r = resumen[op];
+            r.llamadas += c.llamadas.load(memory_order_relaxed);
+            r.registrosLeidos += c.registrosLeidos.load(memory_order_relaxed);
+            r.bytesLeidos += c.bytesLeidos.load(memory_order_relaxed);
+            r.bytesEscritos += c.bytesEscritos.load(memory_order_relaxed);
+            r.aperturas += c.aperturas.load(memory_order_relaxed);
+            r.posicionamientos += c.posicionamientos.load(memory_order_relaxed);
+
+            for (int i = 0; i < CANT_CUBETAS_LATENCIA; i++) {
+                long long cuenta = c.latencia[i].load(memory_order_relaxed);
+                r.latencia.cuentas[i] += cuenta;
+                r.latencia.total += cuenta;
+            }
+            r.latencia.suma += c.latenciaSuma.load(memory_order_relaxed);
+            long long maximo = c.latenciaMaxima.load(memory_order_relaxed);
+            if (maximo > r.latencia.maximo) r.latencia.maximo = maximo;
+        }
+    }
+    return resumen;
+}
+
+// FUNCION: Poner en cero todas las metricas
+void reiniciarMetricas() {
+    lock_guard<mutex> guardia(candadoMetricas);
+    for (MetricasHilo* m : metricasRegistradas) {
+        for (int op = 0; op < CANT_OPERACIONES_METRICA; op++) {
+            ContadoresOperacion& c = m->operaciones[op];
+            c.llamadas.store(0, memory_order_relaxed);
+            c.registrosLeidos.store(0, memory_order_relaxed);
+            c.bytesLeidos.store(0, memory_order_relaxed);
+            c.bytesEscritos.store(0, memory_order_relaxed);
+            c.aperturas.store(0, memory_order_relaxed);
+            c.posicionamientos.store(0, memory_order_relaxed);
+            for (int i = 0; i < CANT_CUBETAS_LATENCIA; i++) c.latencia[i].store(0, memory_order_relaxed);
+            c.latenciaSuma.store(0, memory_order_relaxed);
+            c.latenciaMaxima.store(0, memory_order_relaxed);
+        }
+    }
+    for (const FuenteCache& f : cachesRegistradas) f.reiniciar();
+}
+
+// FUNCION: Mostrar metricas por operacion
+void mostrarMetricas() {
+#ifdef SIN_METRICAS
+    cout << "* Metricas deshabilitadas en esta compilacion (SIN_METRICAS)." << endl;
+    return;
+#endif
+    vector<ResumenOperacion> resumen = leerMetricas();
+
+    cout << "\n** METRICAS DE RENDIMIENTO (latencias en microsegundos)" << endl;
+    cout << "=========================================================" << endl;
+    cout << left << setw(28) << "OPERACION" << right
+         << setw(8) << "LLAM." << setw(10) << "P50" << setw(10) << "P99" << setw(11) << "MAX"
+         << setw(12) << "REG.LEIDOS" << setw(13) << "BYTES LEID." << setw(12) << "BYTES ESC."
+         << setw(9) << "APERT." << setw(9) << "SEEKS" << endl;
+
+    bool hayDatos = false;
+    for (int op = 0; op < CANT_OPERACIONES_METRICA; op++) {
+        const ResumenOperacion& r = resumen[op];
+        if (r.llamadas == 0) continue;
+        hayDatos = true;
+        cout << left << setw(28) << NOMBRES_METRICA[op] << right
+             << setw(8) << r.llamadas
+             << fixed << setprecision(1)
+             << setw(10) << percentilHistograma(r.latencia, 0.50) / 1000.0
+             << setw(10) << percentilHistograma(r.latencia, 0.99) / 1000.0
+             << setw(11) << r.latencia.maximo / 1000.0
+             << setw(12) << r.registrosLeidos
+             << setw(13) << r.bytesLeidos
+             << setw(12) << r.bytesEscritos
+             << setw(9) << r.aperturas
+             << setw(9) << r.posicionamientos << endl;
+    }
+
+    if (!hayDatos) {
+        cout << "* Aun no hay operaciones registradas." << endl;
+    }
+
+    vector<ResumenCache> caches = leerCaches();
+    if (caches.empty()) return;
+    cout << "\n** CACHES DE REGISTROS" << endl;
+    cout << left << setw(14) << "CACHE" << right << setw(11) << "ACIERTOS" << setw(11) << "FALLOS"
+         << setw(8) << "TASA%" << setw(11) << "INVALID." << setw(11) << "EXPULS." << setw(10) << "ENTRADAS"
+         << setw(10) << "USO KB" << setw(10) << "LIMITE KB" << endl;
+    for (const ResumenCache& c : caches) {
+        cout << left << setw(14) << c.nombre << right << setw(11) << c.aciertos << setw(11) << c.fallos
+             << fixed << setprecision(1) << setw(8) << tasaAciertosCache(c)
+             << setw(11) << c.invalidaciones << setw(11) << c.expulsiones << setw(10) << c.entradas
+             << setw(10) << c.bytesUsados / 1024 << setw(10) << c.presupuesto / 1024 << endl;
+    }
+}
+
+// FUNCION: Exportar metricas en JSON
+bool exportarMetricasJSON(const char* nombreArchivo) {
+    ofstream archivo(nombreArchivo);
+    if (!archivo.is_open()) {
+        return false;
+    }
+
+    vector<ResumenOperacion> resumen = leerMetricas();
+    archivo << "{\n  \"operaciones\": [\n";
+    bool primero = true;
+    for (int op = 0; op < CANT_OPERACIONES_METRICA; op++) {
+        const ResumenOperacion& r = resumen[op];
+        if (r.llamadas == 0) continue;
+        archivo << (primero ? "" : ",\n");
+        primero = false;
+        archivo << "    {\"operacion\": \"" << NOMBRES_METRICA[op] << "\""
+                << ", \"llamadas\": " << r.llamadas
+                << ", \"registros_leidos\": " << r.registrosLeidos
+                << ", \"bytes_leidos\": " << r.bytesLeidos
+                << ", \"bytes_escritos\": " << r.bytesEscritos
+                << ", \"aperturas\": " << r.aperturas
+                << ", \"posicionamientos\": " << r.posicionamientos
+                << ", \"latencia_ns\": {\"p50\": " << percentilHistograma(r.latencia, 0.50)
+                << ", \"p90\": " << percentilHistograma(r.latencia, 0.90)
+                << ", \"p99\": " << percentilHistograma(r.latencia, 0.99)
+                << ", \"p999\": " << percentilHistograma(r.latencia, 0.999)
+                << ", \"max\": " << r.latencia.maximo
+                << ", \"suma\": " << r.latencia.suma << "}}";
+    }
+    archivo << "\n  ],\n  \"caches\": [\n";
+    primero = true;
+    for (const ResumenCache& c : leerCaches()) {
+        archivo << (primero ? "" : ",\n");
+        primero = false;
+        archivo << "    {\"cache\": \"" << c.nombre << "\""
+                << ", \"aciertos\": " << c.aciertos
+                << ", \"fallos\": " << c.fallos
+                << ", \"invalidaciones\": " << c.invalidaciones
+                << ", \"expulsiones\": " << c.expulsiones
+                << ", \"entradas\": " << c.entradas
+                << ", \"bytes_usados\": " << c.bytesUsados
+                << ", \"presupuesto_bytes\": " << c.presupuesto << "}";
+    }
+    archivo << "\n  ]\n}\n";
+    return true;
+}
+
+// FUNCION: Exportar metricas en formato de texto de Prometheus
+bool exportarMetricasPrometheus(const char* nombreArchivo) {
+    ofstream archivo(nombreArchivo);
+    if (!archivo.is_open()) {
+        return false;
+    }
+
+    vector<ResumenOperacion> resumen = leerMetricas();
+    struct Contador { const char* nombre; const char* ayuda; long long ResumenOperacion::*campo; };
+    Contador contadores[] = {
+        {"hospital_operaciones_total", "Llamadas a la operacion", &ResumenOperacion::llamadas},
+        {"hospital_registros_leidos_total", "Registros leidos", &ResumenOperacion::registrosLeidos},
+        {"hospital_bytes_leidos_total", "Bytes leidos", &ResumenOperacion::bytesLeidos},
+        {"hospital_bytes_escritos_total", "Bytes escritos", &ResumenOperacion::bytesEscritos},
+        {"hospital_aperturas_archivo_total", "Archivos abiertos", &ResumenOperacion::aperturas},
+        {"hospital_posicionamientos_total", "Posicionamientos (seek)", &ResumenOperacion::posicionamientos}
+    };
+
+    for (const Contador& c : contadores) {
+        archivo << "# HELP " << c.nombre << " " << c.ayuda << "\n";
+        archivo << "# TYPE " << c.nombre << " counter\n";
+        for (int op = 0; op < CANT_OPERACIONES_METRICA; op++) {
+            if (resumen[op].llamadas == 0) continue;
+            archivo << c.nombre << "{operacion=\"" << NOMBRES_METRICA[op] << "\"} "
+                    << resumen[op].*(c.campo) << "\n";
+        }
+    }
+
+    // Histograma con limites en potencias de 2 desde 1 microsegundo
+    archivo << "# HELP hospital_latencia_segundos Latencia por operacion\n";
+    archivo << "# TYPE hospital_latencia_segundos histogram\n";
+    for (int op = 0; op < CANT_OPERACIONES_METRICA; op++) {
+        const ResumenOperacion& r = resumen[op];
+        if (r.llamadas == 0) continue;
+
+        long long acumulado = 0;
+        int cubeta = 0;
+        for (int exponente = 10; exponente <= 36; exponente++) {
+            long long limite = 1LL << exponente;
+            while (cubeta < CANT_CUBETAS_LATENCIA && limiteCubetaLatencia(cubeta) <= limite) {
+                acumulado += r.latencia.cuentas[cubeta++];
+            }
+            archivo << "hospital_latencia_segundos_bucket{operacion=\"" << NOMBRES_METRICA[op]
+                    << "\",le=\"" << setprecision(9) << limite / 1e9 << "\"} " << acumulado << "\n";
+        }
+        archivo << "hospital_latencia_segundos_bucket{operacion=\"" << NOMBRES_METRICA[op]
+                << "\",le=\"+Inf\"} " << r.latencia.total << "\n";
+        archivo << "hospital_latencia_segundos_sum{operacion=\"" << NOMBRES_METRICA[op] << "\"} "
+                << setprecision(9) << r.latencia.suma / 1e9 << "\n";
+        archivo << "hospital_latencia_segundos_count{operacion=\"" << NOMBRES_METRICA[op] << "\"} "
+                << r.latencia.total << "\n";
+    }
+
+    vector<ResumenCache> caches = leerCaches();
+    struct ContadorCache { const char* nombre; const char* ayuda; const char* tipo; long long ResumenCache::*campo; };
+    ContadorCache contadoresCache[] = {
+        {"hospital_cache_aciertos_total", "Busquedas resueltas en la cache", "counter", &ResumenCache::aciertos},
+        {"hospital_cache_fallos_total", "Busquedas que fueron a disco", "counter", &ResumenCache::fallos},
+        {"hospital_cache_invalidaciones_total", "Registros invalidados al escribir", "counter", &ResumenCache::invalidaciones},
+        {"hospital_cache_expulsiones_total", "Registros descartados por el limite", "counter", &ResumenCache::expulsiones},
+        {"hospital_cache_entradas", "Registros en la cache", "gauge", &ResumenCache::entradas},
+        {"hospital_cache_bytes", "Memoria usada por la cache", "gauge", &ResumenCache::bytesUsados}
+    };
+    for (const ContadorCache& c : contadoresCache) {
+        if (caches.empty()) break;
+        archivo << "# HELP " << c.nombre << " " << c.ayuda << "\n";
+        archivo << "# TYPE " << c.nombre << " " << c.tipo << "\n";
+        for (const ResumenCache& r : caches) {
+            archivo << c.nombre << "{cache=\"" << r.nombre << "\"} " << r.*(c.campo) << "\n";
+        }
+    }
+    return true;
+}
+
+#endif //METRICAS_H
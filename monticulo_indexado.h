@@ -0,0 +1,123 @@
+#ifndef MONTICULO_INDEXADO_H
+#define MONTICULO_INDEXADO_H
+
+#include <vector>
+#include <unordered_map>
+
+using namespace std;
+
+// ============================================================================
+// MONTICULO DE MINIMOS INDEXADO
+// ============================================================================
+// Monticulo binario de IDs ordenados por una clave entera (a igual clave,
+// por ID). Ademas del arreglo del monticulo guarda la posicion de cada ID,
+// asi cambiar la clave de un elemento cualquiera es O(log n): se ubica
+// directo y se sube o se baja. El minimo se lee en O(1).
+
+struct ElementoMonticulo {
+    long clave;
+    int id;
+};
+
+struct MonticuloIndexado {
+    vector<ElementoMonticulo> elementos;
+    unordered_map<int, int> posicion;       // id -> posicion en elementos
+};
+
+inline bool menorElemento(const ElementoMonticulo& a, const ElementoMonticulo& b) {
+    return a.clave != b.clave ? a.clave < b.clave : a.id < b.id;
+}
+
+void intercambiarEnMonticulo(MonticuloIndexado& m, int i, int j) {
+    ElementoMonticulo temp = m.elementos[i];
+    m.elementos[i] = m.elementos[j];
+    m.elementos[j] = temp;
+    m.posicion[m.elementos[i].id] = i;
+    m.posicion[m.elementos[j].id] = j;
+}
+
+void subirEnMonticulo(MonticuloIndexado& m, int i) {
+    while (i > 0) {
+        int padre = (i - 1) / 2;
+        if (!menorElemento(m.elementos[i], m.elementos[padre])) break;
+        intercambiarEnMonticulo(m, i, padre);
+        i = padre;
+    }
+}
+
+void bajarEnMonticulo(MonticuloIndexado& m, int i) {
+    int cantidad = (int)m.elementos.size();
+    while (true) {
+        int menor = i;
+        int izquierdo = 2 * i + 1, derecho = 2 * i + 2;
+        if (izquierdo < cantidad && menorElemento(m.elementos[izquierdo], m.elementos[menor])) menor = izquierdo;
+        if (derecho < cantidad && menorElemento(m.elementos[derecho], m.elementos[menor])) menor = derecho;
+        if (menor == i) break;
+        intercambiarEnMonticulo(m, i, menor);
+        i = menor;
+    }
+}
+
+// FUNCION: Agregar un ID o, si ya esta, cambiar su clave
+void fijarClaveMonticulo(MonticuloIndexado& m, int id, long clave) {
+    auto encontrado = m.posicion.find(id);
+    if (encontrado == m.posicion.end()) {
+        m.elementos.push_back({clave, id});
+        m.posicion[id] = (int)m.elementos.size() - 1;
+        subirEnMonticulo(m, (int)m.elementos.size() - 1);
+        return;
+    }
+
+    int i = encontrado->second;
+    long anterior = m.elementos[i].clave;
+    m.elementos[i].clave = clave;
+    if (clave < anterior) {
+        subirEnMonticulo(m, i);
+    } else {
+        bajarEnMonticulo(m, i);
+    }
+}
+
+// FUNCION: Sumar delta a la clave de un ID que ya esta (false si no esta)
+bool sumarClaveMonticulo(MonticuloIndexado& m, int id, long delta) {
+    auto encontrado = m.posicion.find(id);
+    if (encontrado == m.posicion.end()) return false;
+    fijarClaveMonticulo(m, id, m.elementos[encontrado->second].clave + delta);
+    return true;
+}
+
+// FUNCION: Quitar un ID (false si no esta)
+bool quitarDeMonticulo(MonticuloIndexado& m, int id) {
+    auto encontrado = m.posicion.find(id);
+    if (encontrado == m.posicion.end()) return false;
+
+    int i = encontrado->second;
+    int ultimo = (int)m.elementos.size() - 1;
+    if (i != ultimo) intercambiarEnMonticulo(m, i, ultimo);
+    m.posicion.erase(id);
+    m.elementos.pop_back();
+    if (i < (int)m.elementos.size()) {
+        subirEnMonticulo(m, i);
+        bajarEnMonticulo(m, i);
+    }
+    return true;
+}
+
+// FUNCION: Armar el monticulo de una vez a partir de sus elementos (O(n))
+void construirMonticulo(MonticuloIndexado& m, const vector<ElementoMonticulo>& elementos) {
+    m.elementos = elementos;
+    m.posicion.clear();
+    for (int i = 0; i < (int)m.elementos.size(); i++) m.posicion[m.elementos[i].id] = i;
+    for (int i = (int)m.elementos.size() / 2 - 1; i >= 0; i--) bajarEnMonticulo(m, i);
+}
+
+inline bool monticuloVacio(const MonticuloIndexado& m) {
+    return m.elementos.empty();
+}
+
+// Elemento de menor clave; el monticulo no debe estar vacio
+inline const ElementoMonticulo& minimoMonticulo(const MonticuloIndexado& m) {
+    return m.elementos[0];
+}
+
+#endif //MONTICULO_INDEXADO_H
@@ -0,0 +1,163 @@
+#ifndef POOL_HILOS_H
+#define POOL_HILOS_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+
+using namespace std;
+
+// ============================================================================
+// POOL DE HILOS CON ROBO DE TRABAJO
+// ============================================================================
+// Para recorrer archivos grandes en paralelo: el trabajo se parte en rangos
+// [inicio, fin) que se reparten en una cola por hilo. Cada hilo toma de la
+// punta de su cola y, cuando se queda sin trabajo, roba del otro extremo de
+// la cola de otro hilo. Asi un rango lento (disco frio, registros mas
+// caros) no deja a los demas hilos esperando.
+//
+// trabajo(inicio, fin, hilo) recibe el numero de hilo (0..hilos-1) para que
+// cada uno acumule en su propio parcial sin candados; quien llama fusiona
+// los parciales al terminar. Las colas usan un mutex cada una: los rangos
+// son de miles de registros y el costo de tomarlos es despreciable.
+//
+// Un lote a la vez: paraCadaRango no debe llamarse desde dentro de un trabajo.
+
+struct RangoTrabajo {
+    long inicio;
+    long fin;
+};
+
+struct ColaTrabajo {
+    mutex candado;
+    deque<RangoTrabajo> rangos;
+};
+
+struct PoolHilos {
+    vector<thread> hilos;
+    vector<ColaTrabajo> colas;
+
+    mutex candado;                          // Protege generacion y cerrando
+    condition_variable hayTrabajo;
+    condition_variable loteTerminado;
+    long generacion;
+    bool cerrando;
+
+    mutex candadoLote;                      // Un lote a la vez
+    const function<void(long, long, int)>* trabajo;
+    atomic<long> pendientes;
+    atomic<long> robados;                   // Rangos ejecutados por otro hilo (estadistica)
+
+    explicit PoolHilos(int cantidad);
+    ~PoolHilos();
+};
+
+// FUNCION: Tomar un rango: primero de la cola propia, si no, robar
+bool tomarRango(PoolHilos& pool, int hilo, RangoTrabajo& rango) {
+    int cantidad = (int)pool.colas.size();
+    {
+        ColaTrabajo& propia = pool.colas[hilo];
+        lock_guard<mutex> guardia(propia.candado);
+        if (!propia.rangos.empty()) {
+            rango = propia.rangos.back();
+            propia.rangos.pop_back();
+            return true;
+        }
+    }
+    for (int k = 1; k < cantidad; k++) {
+        ColaTrabajo& otra = pool.colas[(hilo + k) % cantidad];
+        lock_guard<mutex> guardia(otra.candado);
+        if (!otra.rangos.empty()) {
+            rango = otra.rangos.front();
+            otra.rangos.pop_front();
+            pool.robados.fetch_add(1, memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void trabajadorPool(PoolHilos* pool, int hilo) {
+    long vista = 0;
+    while (true) {
+        {
+            unique_lock<mutex> guardia(pool->candado);
+            pool->hayTrabajo.wait(guardia, [&]() { return pool->cerrando || pool->generacion != vista; });
+            if (pool->cerrando) return;
+            vista = pool->generacion;
+        }
+
+        RangoTrabajo rango;
+        while (tomarRango(*pool, hilo, rango)) {
+            (*pool->trabajo)(rango.inicio, rango.fin, hilo);
+            if (pool->pendientes.fetch_sub(1, memory_order_acq_rel) == 1) {
+                lock_guard<mutex> guardia(pool->candado);
+                pool->loteTerminado.notify_all();
+            }
+        }
+    }
+}
+
+PoolHilos::PoolHilos(int cantidad) : colas(max(1, cantidad)) {
+    generacion = 0;
+    cerrando = false;
+    trabajo = nullptr;
+    pendientes = 0;
+    robados = 0;
+    for (int i = 0; i < (int)colas.size(); i++) {
+        hilos.push_back(thread(trabajadorPool, this, i));
+    }
+}
+
+PoolHilos::~PoolHilos() {
+    {
+        lock_guard<mutex> guardia(candado);
+        cerrando = true;
+    }
+    hayTrabajo.notify_all();
+    for (thread& h : hilos) h.join();
+}
+
+int cantidadHilosPool(const PoolHilos& pool) {
+    return (int)pool.colas.size();
+}
+
+// FUNCION: Ejecutar trabajo sobre [0, total) en rangos de tamanoRango y
+// esperar a que terminen todos
+void paraCadaRango(PoolHilos& pool, long total, long tamanoRango,
+                   const function<void(long, long, int)>& trabajo) {
+    if (total <= 0) return;
+    if (tamanoRango <= 0) tamanoRango = total;
+    lock_guard<mutex> lote(pool.candadoLote);
+
+    long cantidadRangos = (total + tamanoRango - 1) / tamanoRango;
+    int hilos = cantidadHilosPool(pool);
+    pool.trabajo = &trabajo;
+    pool.pendientes.store(cantidadRangos, memory_order_release);
+
+    // Rangos contiguos por hilo: cada uno empieza leyendo una zona propia del archivo
+    for (long r = 0; r < cantidadRangos; r++) {
+        int hilo = (int)(r * hilos / cantidadRangos);
+        lock_guard<mutex> guardia(pool.colas[hilo].candado);
+        pool.colas[hilo].rangos.push_front({r * tamanoRango, min(total, (r + 1) * tamanoRango)});
+    }
+
+    unique_lock<mutex> guardia(pool.candado);
+    pool.generacion++;
+    pool.hayTrabajo.notify_all();
+    pool.loteTerminado.wait(guardia, [&]() { return pool.pendientes.load(memory_order_acquire) == 0; });
+    pool.trabajo = nullptr;
+}
+
+// Pool compartido del sistema, con un hilo por nucleo
+PoolHilos& poolGlobal() {
+    static PoolHilos pool(max(1, (int)thread::hardware_concurrency()));
+    return pool;
+}
+
+#endif //POOL_HILOS_H
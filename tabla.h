@@ -0,0 +1,170 @@
+#ifndef TABLA_H
+#define TABLA_H
+
+#include <iostream>
+#include <vector>
+#include <cstring>
+#include <charconv>
+#include "fecha.h"
+
+using namespace std;
+
+// ============================================================================
+// SALIDA DE TABLAS CON BUFFER
+// ============================================================================
+// Los listados escriben cada celda en un buffer propio de ancho fijo, sin
+// strings temporales ni setw: los numeros se convierten con to_chars y los
+// textos se copian recortados al ancho de la columna. El buffer se entrega
+// a la consola en bloques de TAMANO_BUFFER_TABLA y se vacia (flush) una
+// sola vez al final o antes de pedir la siguiente pagina; un listado de
+// 100k filas no paga un flush ni una reserva de memoria por fila.
+//
+// Los anchos se cuentan en bytes, igual que setw.
+
+const size_t TAMANO_BUFFER_TABLA = 64 * 1024;
+const int FILAS_POR_PAGINA = 25;
+
+struct SalidaTabla {
+    ostream* destino;
+    vector<char> buffer;
+    size_t usado;
+};
+
+void iniciarSalidaTabla(SalidaTabla& s, ostream& destino = cout) {
+    s.destino = &destino;
+    s.buffer.resize(TAMANO_BUFFER_TABLA);
+    s.usado = 0;
+}
+
+// FUNCION: Entregar lo acumulado al destino (sin flush)
+void entregarSalidaTabla(SalidaTabla& s) {
+    if (s.usado > 0) {
+        s.destino->write(s.buffer.data(), (streamsize)s.usado);
+        s.usado = 0;
+    }
+}
+
+// FUNCION: Entregar lo acumulado y vaciar el destino (fin del listado o de una pagina)
+void vaciarSalidaTabla(SalidaTabla& s) {
+    entregarSalidaTabla(s);
+    s.destino->flush();
+}
+
+// Lugar para bytes mas; si no entra se entrega lo acumulado primero.
+// bytes no debe superar TAMANO_BUFFER_TABLA.
+inline char* reservarEnTabla(SalidaTabla& s, size_t bytes) {
+    if (s.usado + bytes > s.buffer.size()) entregarSalidaTabla(s);
+    return s.buffer.data() + s.usado;
+}
+
+void escribirEnTabla(SalidaTabla& s, const char* texto, size_t largo) {
+    while (largo > 0) {
+        size_t parte = largo < s.buffer.size() ? largo : s.buffer.size();
+        memcpy(reservarEnTabla(s, parte), texto, parte);
+        s.usado += parte;
+        texto += parte;
+        largo -= parte;
+    }
+}
+
+void escribirEnTabla(SalidaTabla& s, const char* texto) {
+    escribirEnTabla(s, texto, strlen(texto));
+}
+
+void finFilaTabla(SalidaTabla& s) {
+    *reservarEnTabla(s, 1) = '\n';
+    s.usado++;
+}
+
+// FUNCION: Texto alineado a la izquierda, recortado o completado con espacios
+void celdaTexto(SalidaTabla& s, const char* texto, int ancho) {
+    char* destino = reservarEnTabla(s, ancho);
+    size_t largo = strnlen(texto, ancho);
+    memcpy(destino, texto, largo);
+    memset(destino + largo, ' ', ancho - largo);
+    s.usado += ancho;
+}
+
+// FUNCION: Igual, para un campo de capacidad fija que puede no terminar en '\0'
+void celdaTexto(SalidaTabla& s, const char* texto, size_t capacidad, int ancho) {
+    char* destino = reservarEnTabla(s, ancho);
+    size_t largo = strnlen(texto, capacidad < (size_t)ancho ? capacidad : (size_t)ancho);
+    memcpy(destino, texto, largo);
+    memset(destino + largo, ' ', ancho - largo);
+    s.usado += ancho;
+}
+
+// FUNCION: "nombre apellido" en una celda, sin armar el string completo
+void celdaNombre(SalidaTabla& s, const char* nombre, const char* apellido, int ancho) {
+    char* destino = reservarEnTabla(s, ancho);
+    size_t largo = strnlen(nombre, ancho);
+    memcpy(destino, nombre, largo);
+    if ((int)largo < ancho) destino[largo++] = ' ';
+    size_t resto = strnlen(apellido, ancho - largo);
+    memcpy(destino + largo, apellido, resto);
+    largo += resto;
+    memset(destino + largo, ' ', ancho - largo);
+    s.usado += ancho;
+}
+
+// Alinea a la derecha los bytes [texto, fin); si no entran se escriben completos
+void celdaDerecha(SalidaTabla& s, const char* texto, const char* fin, int ancho) {
+    int largo = (int)(fin - texto);
+    int relleno = ancho > largo ? ancho - largo : 0;
+    char* destino = reservarEnTabla(s, relleno + largo);
+    memset(destino, ' ', relleno);
+    memcpy(destino + relleno, texto, largo);
+    s.usado += relleno + largo;
+}
+
+void celdaEntero(SalidaTabla& s, long long valor, int ancho) {
+    char texto[24];
+    to_chars_result r = to_chars(texto, texto + sizeof(texto), valor);
+    celdaDerecha(s, texto, r.ptr, ancho);
+}
+
+void celdaDecimal(SalidaTabla& s, double valor, int decimales, int ancho) {
+    char texto[64];
+    to_chars_result r = to_chars(texto, texto + sizeof(texto), valor, chars_format::fixed, decimales);
+    if (r.ec != errc()) {
+        texto[0] = '?';
+        r.ptr = texto + 1;
+    }
+    celdaDerecha(s, texto, r.ptr, ancho);
+}
+
+void celdaFecha(SalidaTabla& s, Fecha fecha, int ancho) {
+    char texto[11];
+    if (fecha == FECHA_INVALIDA) {
+        celdaTexto(s, "----------", ancho);
+        return;
+    }
+    formatearFecha(fecha, texto);
+    celdaTexto(s, texto, ancho);
+}
+
+void celdaHora(SalidaTabla& s, Hora hora, int ancho) {
+    char texto[6];
+    if (hora < 0 || hora >= MINUTOS_POR_DIA) {
+        celdaTexto(s, "--:--", ancho);
+        return;
+    }
+    formatearHora(hora, texto);
+    celdaTexto(s, texto, ancho);
+}
+
+// FUNCION: Entregar la pagina y preguntar si se sigue (false con 'q' o fin de la entrada)
+bool pedirSiguientePagina(SalidaTabla& s) {
+    escribirEnTabla(s, "-- Enter: siguiente pagina, q: terminar -- ");
+    vaciarSalidaTabla(s);
+    char respuesta[8];
+    cin.getline(respuesta, sizeof(respuesta));
+    if (!cin) {
+        if (cin.eof()) return false;
+        cin.clear();
+        cin.ignore(10000, '\n');
+    }
+    return respuesta[0] != 'q' && respuesta[0] != 'Q';
+}
+
+#endif //TABLA_H
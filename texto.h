@@ -0,0 +1,110 @@
+#ifndef TEXTO_H
+#define TEXTO_H
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+// ============================================================================
+// NORMALIZACION DE TEXTO
+// ============================================================================
+// Las busquedas comparan texto sin mayusculas ni acentos: "Núñez", "NUNEZ" y
+// "nuñez" dan la misma clave. Se aceptan bytes Latin-1 y secuencias UTF-8 de
+// dos bytes (U+00C0..U+00FF), segun lo que haya escrito la consola.
+
+// Plegado de Latin-1 0xC0..0xFF; '.' marca un caracter que se descarta
+const char PLEGADO_LATIN1[] =
+    "AAAAAAACEEEEIIIIDNOOOOO.OUUUUY.S"
+    "AAAAAAACEEEEIIIIDNOOOOO.OUUUUY.Y";
+
+// FUNCION: Plegar un caracter a su letra base en mayuscula (0 si se descarta)
+char plegarCaracter(unsigned char c) {
+    if (c >= 'a' && c <= 'z') return c - 'a' + 'A';
+    if ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) return c;
+    if (c >= 0xC0) {
+        char plegado = PLEGADO_LATIN1[c - 0xC0];
+        return plegado == '.' ? 0 : plegado;
+    }
+    return 0;
+}
+
+// FUNCION: Normalizar texto: mayusculas sin acentos, solo letras, digitos y
+// un espacio entre palabras. Devuelve la longitud escrita en destino.
+int normalizarTexto(const char* origen, char* destino, int largoMaximo) {
+    int largo = 0;
+    bool espacioPendiente = false;
+
+    for (const unsigned char* p = (const unsigned char*)origen; *p != 0; p++) {
+        unsigned char c = *p;
+
+        // UTF-8: C3 xx corresponde a Latin-1 xx + 0x40; otras secuencias se omiten
+        if (c == 0xC3 && p[1] >= 0x80 && p[1] <= 0xBF) {
+            c = (unsigned char)(p[1] + 0x40);
+            p++;
+        } else if (c >= 0xC2 && c <= 0xF4 && p[1] >= 0x80 && p[1] <= 0xBF) {
+            while (p[1] >= 0x80 && p[1] <= 0xBF) p++;
+            c = ' ';
+        }
+
+        char plegado = plegarCaracter(c);
+        if (plegado == 0) {
+            if (c == ' ' || c == '\t' || c == '-' || c == '/' || c == ',' || c == '.') {
+                espacioPendiente = largo > 0;
+            }
+            continue;
+        }
+
+        if (espacioPendiente) {
+            if (largo >= largoMaximo) break;
+            destino[largo++] = ' ';
+            espacioPendiente = false;
+        }
+        if (largo >= largoMaximo) break;
+        destino[largo++] = plegado;
+    }
+
+    if (largo < largoMaximo) destino[largo] = '\0';
+    return largo;
+}
+
+// ============================================================================
+// TOKENIZACION PARA BUSQUEDA DE TEXTO
+// ============================================================================
+
+const int LARGO_MINIMO_TERMINO = 3;
+
+// Palabras muy frecuentes que no sirven para buscar (ya normalizadas)
+const char* PALABRAS_VACIAS[] = {
+    "LOS", "LAS", "DEL", "CON", "POR", "PARA", "UNA", "UNO", "CADA", "SIN",
+    "SUS", "MAS", "COMO", "QUE", "ENTRE", "SOBRE", "HASTA", "DESDE"
+};
+
+bool esPalabraVacia(const string& termino) {
+    for (const char* palabra : PALABRAS_VACIAS) {
+        if (termino == palabra) return true;
+    }
+    return false;
+}
+
+// FUNCION: Agregar a terminos las palabras normalizadas de un texto.
+// Se descartan las palabras cortas y las vacias; las largas se recortan.
+void tokenizarTexto(const char* texto, vector<string>& terminos, int largoMaximo) {
+    vector<char> normalizado(strlen(texto) + 1);
+    int largo = normalizarTexto(texto, normalizado.data(), (int)normalizado.size());
+
+    int inicio = 0;
+    for (int i = 0; i <= largo; i++) {
+        if (i < largo && normalizado[i] != ' ') continue;
+        int largoPalabra = i - inicio;
+        if (largoPalabra >= LARGO_MINIMO_TERMINO) {
+            string termino(&normalizado[inicio], min(largoPalabra, largoMaximo));
+            if (!esPalabraVacia(termino)) terminos.push_back(termino);
+        }
+        inicio = i + 1;
+    }
+}
+
+#endif //TEXTO_H
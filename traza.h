@@ -0,0 +1,200 @@
+#ifndef TRAZA_H
+#define TRAZA_H
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <chrono>
+#include "metricas.h"
+
+using namespace std;
+
+// ============================================================================
+// TRAZA DE SPANS (formato Chrome Trace Event / Perfetto)
+// ============================================================================
+// Un span mide un bloque con alcance (una accion del menu o una funcion de
+// almacenamiento) y al cerrarse deja un evento con su duracion y los
+// registros/bytes leidos y escritos dentro de el. Los spans anidados del mismo
+// hilo se ven como una pila en chrome://tracing o ui.perfetto.dev.
+//
+// Cada hilo escribe en su propio buffer circular sin candados (un productor,
+// un consumidor). Si el buffer se llena antes de vaciarlo, el evento se
+// descarta y se cuenta como perdido.
+//
+// La traza se activa en tiempo de ejecucion con activarTraza(). Compilar con
+// -DSIN_TRAZA elimina toda la instrumentacion. Los registros leidos salen de
+// metricas.h, por lo que con -DSIN_METRICAS aparecen en cero.
+
+const int CAPACIDAD_BUFFER_TRAZA = 65536;    // Eventos por hilo (potencia de 2)
+
+struct EventoTraza {
+    const char* nombre;          // Literal o cadena estatica: solo se guarda el puntero
+    const char* categoria;
+    long long inicio;            // Nanosegundos desde inicioTraza
+    long long duracion;
+    long long registrosLeidos;
+    long long bytesLeidos;
+    long long bytesEscritos;
+};
+
+struct BufferTraza {
+    EventoTraza eventos[CAPACIDAD_BUFFER_TRAZA];
+    atomic<unsigned long long> cabeza;    // Solo la escribe el hilo duenio
+    atomic<unsigned long long> cola;      // Solo la escribe quien vacia
+    atomic<long long> perdidos;
+    int hilo;
+};
+
+atomic<bool> trazaActiva(false);
+const chrono::steady_clock::time_point inicioTraza = chrono::steady_clock::now();
+
+// Registro de buffers; el candado solo se toma al registrar un hilo y al vaciar
+mutex candadoTraza;
+vector<BufferTraza*> buffersTraza;
+vector<EventoTraza> eventosVaciados;
+vector<int> hilosVaciados;
+thread_local BufferTraza* bufferTrazaActual = nullptr;
+
+BufferTraza& bufferTrazaDelHilo() {
+    if (bufferTrazaActual == nullptr) {
+        BufferTraza* nuevo = new BufferTraza();
+        lock_guard<mutex> guardia(candadoTraza);
+        nuevo->hilo = (int)buffersTraza.size() + 1;
+        buffersTraza.push_back(nuevo);
+        bufferTrazaActual = nuevo;
+    }
+    return *bufferTrazaActual;
+}
+
+long long nanosTraza() {
+    return chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now() - inicioTraza).count();
+}
+
+// FUNCION: Publicar un evento en el buffer del hilo actual
+void publicarEventoTraza(const EventoTraza& evento) {
+    BufferTraza& b = bufferTrazaDelHilo();
+    unsigned long long cabeza = b.cabeza.load(memory_order_relaxed);
+    if (cabeza - b.cola.load(memory_order_acquire) >= CAPACIDAD_BUFFER_TRAZA) {
+        sumarRelajado(b.perdidos, 1);
+        return;
+    }
+    b.eventos[cabeza & (CAPACIDAD_BUFFER_TRAZA - 1)] = evento;
+    b.cabeza.store(cabeza + 1, memory_order_release);
+}
+
+// Span con alcance: el evento se publica al salir del bloque
+struct SpanTraza {
+    EventoTraza evento;
+    ContadoresIOHilo ioInicial;
+    bool activo;
+
+    SpanTraza(const char* nombre, const char* categoria) {
+        activo = trazaActiva.load(memory_order_relaxed);
+        if (!activo) return;
+        evento.nombre = nombre;
+        evento.categoria = categoria;
+        ioInicial = metricasDelHilo().io;
+        evento.inicio = nanosTraza();
+    }
+
+    ~SpanTraza() {
+        if (!activo) return;
+        evento.duracion = nanosTraza() - evento.inicio;
+        const ContadoresIOHilo& io = metricasDelHilo().io;
+        evento.registrosLeidos = io.registrosLeidos - ioInicial.registrosLeidos;
+        evento.bytesLeidos = io.bytesLeidos - ioInicial.bytesLeidos;
+        evento.bytesEscritos = io.bytesEscritos - ioInicial.bytesEscritos;
+        publicarEventoTraza(evento);
+    }
+};
+
+#ifndef SIN_TRAZA
+#define TRAZA_ACCION(nombre) SpanTraza spanAccion(nombre, "accion")
+#define TRAZA_OPERACION(op) SpanTraza spanOperacion(NOMBRES_METRICA[op], "almacenamiento")
+#else
+#define TRAZA_ACCION(nombre) ((void)0)
+#define TRAZA_OPERACION(op) ((void)0)
+#endif
+
+// Metricas y traza de una funcion de almacenamiento
+#define INSTRUMENTAR(op) MEDIR_OPERACION(op); TRAZA_OPERACION(op)
+
+// ============================================================================
+// CONTROL Y EXPORTACION
+// ============================================================================
+
+void activarTraza(bool activa) {
+    trazaActiva.store(activa, memory_order_relaxed);
+}
+
+// FUNCION: Mover los eventos de todos los hilos a la lista vaciada.
+// Puede llamarse periodicamente mientras otros hilos siguen trazando.
+void vaciarTraza() {
+    lock_guard<mutex> guardia(candadoTraza);
+    for (BufferTraza* b : buffersTraza) {
+        unsigned long long cola = b->cola.load(memory_order_relaxed);
+        unsigned long long cabeza = b->cabeza.load(memory_order_acquire);
+        for (; cola < cabeza; cola++) {
+            eventosVaciados.push_back(b->eventos[cola & (CAPACIDAD_BUFFER_TRAZA - 1)]);
+            hilosVaciados.push_back(b->hilo);
+        }
+        b->cola.store(cabeza, memory_order_release);
+    }
+}
+
+// FUNCION: Descartar todos los eventos registrados
+void reiniciarTraza() {
+    vaciarTraza();
+    lock_guard<mutex> guardia(candadoTraza);
+    eventosVaciados.clear();
+    hilosVaciados.clear();
+    for (BufferTraza* b : buffersTraza) b->perdidos.store(0, memory_order_relaxed);
+}
+
+// FUNCION: Cantidad de eventos listos para exportar
+size_t eventosEnTraza() {
+    vaciarTraza();
+    lock_guard<mutex> guardia(candadoTraza);
+    return eventosVaciados.size();
+}
+
+// FUNCION: Exportar la traza como JSON de Chrome Trace Event
+bool exportarTrazaChrome(const char* nombreArchivo) {
+    ofstream archivo(nombreArchivo);
+    if (!archivo.is_open()) {
+        return false;
+    }
+
+    vaciarTraza();
+    lock_guard<mutex> guardia(candadoTraza);
+
+    long long perdidos = 0;
+    archivo << "{\"traceEvents\": [\n";
+    for (BufferTraza* b : buffersTraza) {
+        perdidos += b->perdidos.load(memory_order_relaxed);
+        archivo << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << b->hilo
+                << ", \"args\": {\"name\": \"hilo " << b->hilo << "\"}},\n";
+    }
+
+    // ts y dur van en microsegundos
+    archivo << fixed << setprecision(3);
+    for (size_t i = 0; i < eventosVaciados.size(); i++) {
+        const EventoTraza& e = eventosVaciados[i];
+        archivo << "  {\"name\": \"" << e.nombre << "\", \"cat\": \"" << e.categoria
+                << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << hilosVaciados[i]
+                << ", \"ts\": " << e.inicio / 1000.0
+                << ", \"dur\": " << e.duracion / 1000.0
+                << ", \"args\": {\"registros_leidos\": " << e.registrosLeidos
+                << ", \"bytes_leidos\": " << e.bytesLeidos
+                << ", \"bytes_escritos\": " << e.bytesEscritos << "}},\n";
+    }
+    archivo << "  {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"hospital\"}}\n";
+    archivo << "], \"displayTimeUnit\": \"ms\", \"otherData\": {\"eventos_perdidos\": " << perdidos << "}}\n";
+    return true;
+}
+
+#endif //TRAZA_H